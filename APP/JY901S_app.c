@@ -6,18 +6,43 @@
 
 // 全局IMU数据定义
 IMU_Data_t imu_data = {
+    .ax = 0.0f,               // 加速度初始值
+    .ay = 0.0f,
+    .az = 0.0f,
+    .gx = 0.0f,               // 角速度初始值
+    .gy = 0.0f,
+    .gz = 0.0f,
     .roll = 0.0f,             // 横滚角初始值
     .pitch = 0.0f,            // 俯仰角初始值
     .yaw = 0.0f,              // 偏航角初始值
+    .sample_time = 0,         // 采样时间
+    .sample_seq = 0,          // 采样序号
+    .sample_us = 0,           // 采集时刻(us)
     .data_ready = 0,          // 数据就绪标志
     .last_update_time = 0,    // 上次更新时间
     .comm_error_count = 0,    // 通信错误计数
     .init_status = 0          // 初始化状态
 };
 
+// IMU配置档 (启动时与模块回读比较，不同才写入)
+IMU_Config_t imu_config = {
+    .rate = IMU_CFG_RATE,
+    .bandwidth = IMU_CFG_BANDWIDTH,
+    .content = IMU_CFG_CONTENT,
+    .axis6 = IMU_CFG_AXIS6
+};
+uint8_t imu_config_result = IMU_CFG_F_ERROR; // 最近一次应用结果 (IMU_CFG_F_*)
+
+#define IMU_REG_NONE          0xFFFFu      // 无等待中的寄存器读取
+static volatile uint32_t imu_reg_pending = IMU_REG_NONE; // 等待应答的起始寄存器
+static volatile uint8_t imu_reg_done = 0;                // 寄存器读取已应答
+#if IMU_TRANSPORT != IMU_TRANSPORT_UART
+static uint32_t imu_acq_us = 0;                          // I2C连续读取开始时刻(us)
+#endif
+
 /**
  * @brief IMU初始化函数
- * 初始化维特SDK，注册I2C读写函数和回调函数
+ * 初始化维特SDK，按IMU_TRANSPORT注册I2C读写函数或串口写函数，以及回调函数
  */
 void IMU_Init(void)
 {
@@ -27,15 +52,25 @@ void IMU_Init(void)
     imu_data.roll = 0.0f;
     imu_data.pitch = 0.0f;
     imu_data.yaw = 0.0f;
+    imu_data.ax = imu_data.ay = imu_data.az = 0.0f;
+    imu_data.gx = imu_data.gy = imu_data.gz = 0.0f;
+    imu_data.sample_time = 0;
+    imu_data.sample_seq = 0;
+    imu_data.sample_us = 0;
     imu_data.data_ready = 0;
     imu_data.last_update_time = HAL_GetTick();
     imu_data.comm_error_count = 0;
     imu_data.init_status = 0;
+    Heading_Init(&heading_data);
 
-    // 1. 注册I2C读写函数到维特SDK
+    // 1. 注册读写函数到维特SDK
+#if IMU_TRANSPORT == IMU_TRANSPORT_UART
+    result = WitSerialWriteRegister(IMU_Stream_Write);
+#else
     result = WitI2cFuncRegister(IMU_I2C_Write, IMU_I2C_Read);
+#endif
     if (result != WIT_HAL_OK) {
-        // I2C函数注册失败
+        // 读写函数注册失败
         return;
     }
 
@@ -53,56 +88,118 @@ void IMU_Init(void)
         return;
     }
 
+#if IMU_TRANSPORT == IMU_TRANSPORT_UART
+    // 4. 初始化维特SDK为串口标准协议，启动USART1循环DMA接收
+    result = WitInit(WIT_PROTOCOL_NORMAL, IMU_I2C_ADDR);
+    if (result != WIT_HAL_OK || !IMU_Stream_Start()) {
+        return;
+    }
+#else
     // 4. 初始化维特SDK为I2C协议模式，设备地址0x50
     result = WitInit(WIT_PROTOCOL_I2C, IMU_I2C_ADDR);
     if (result != WIT_HAL_OK) {
         // SDK初始化失败
         return;
     }
+#endif
+
+    // 5. 应用配置档：输出速率、带宽、输出内容、6/9轴算法，仅在回读不一致时写入
+    imu_config_result = IMU_ApplyConfig(&imu_config);
 
     // 初始化成功
     imu_data.init_status = 1;
 }
 
 /**
- * @brief 设置IMU为6轴模式(纯陀螺仪+加速度计，不使用磁力计)
- * 避免磁场干扰，提高平移运动时的角度稳定性
+ * @brief 写需要解锁的配置寄存器 (先写KEY解锁，再写目标寄存器)
  * @return 1-成功，0-失败
  */
-int32_t IMU_SetGyroOnlyMode(void)
+static uint8_t IMU_WriteUnlocked(uint32_t reg, uint16_t value)
 {
-    int32_t result;
-    uint8_t unlock_key = 0x69;  // KEY_UNLOCK值
-    uint8_t axis6_mode = ALGRITHM6;  // 6轴算法模式
-
     // 1. 解锁寄存器
-    result = WitWriteReg(KEY, unlock_key);
-    if (result != WIT_HAL_OK) {
+    if (WitWriteReg(KEY, KEY_UNLOCK) != WIT_HAL_OK) {
         return 0;  // 解锁失败
     }
 
     // 延时等待解锁生效
-    HAL_Delay(20);
+    HAL_Delay(IMU_CFG_WRITE_DELAY_MS);
 
-    // 2. 设置为6轴算法模式（不使用磁力计）
-    result = WitWriteReg(AXIS6, axis6_mode);
-    if (result != WIT_HAL_OK) {
+    // 2. 写目标寄存器
+    if (WitWriteReg(reg, value) != WIT_HAL_OK) {
         return 0;  // 设置失败
     }
 
     // 延时等待设置生效
-    HAL_Delay(20);
+    HAL_Delay(IMU_CFG_WRITE_DELAY_MS);
+    return 1;
+}
 
-    // 3. 保存配置到FLASH
-    result = WitWriteReg(SAVE, 0x00);
-    if (result != WIT_HAL_OK) {
+/**
+ * @brief 保存模块配置到FLASH
+ * @return 1-成功，0-失败
+ */
+static uint8_t IMU_SaveConfig(void)
+{
+    if (WitWriteReg(SAVE, SAVE_PARAM) != WIT_HAL_OK) {
         return 0;  // 保存失败
     }
 
     // 延时等待保存完成
-    HAL_Delay(100);
+    HAL_Delay(IMU_CFG_SAVE_DELAY_MS);
+    return 1;
+}
+
+/**
+ * @brief 设置姿态算法模式 (不保存到模块FLASH)
+ * @param mode ALGRITHM6-6轴(不使用磁力计)，ALGRITHM9-9轴
+ * @return 1-成功，0-失败
+ */
+uint8_t IMU_SetAlgorithmMode(uint8_t mode)
+{
+    return IMU_WriteUnlocked(AXIS6, mode);
+}
+
+/**
+ * @brief 设置IMU为6轴模式(纯陀螺仪+加速度计，不使用磁力计)
+ * 避免磁场干扰，提高平移运动时的角度稳定性
+ * @return 1-成功，0-失败
+ */
+int32_t IMU_SetGyroOnlyMode(void)
+{
+    // 设置为6轴算法模式（不使用磁力计）并保存配置到FLASH
+    if (!IMU_SetAlgorithmMode(ALGRITHM6)) {
+        return 0;
+    }
+    return IMU_SaveConfig();
+}
+
+/**
+ * @brief 同步读取寄存器到sReg
+ * I2C模式下WitReadReg直接完成读取；串口模式下模块以0x5F帧应答，
+ * 轮询串口流直到应答到达或超时。读取成功以回调收到起始寄存器为准
+ * @param reg 起始寄存器
+ * @param num 寄存器数量 (串口模式每次应答固定4个)
+ * @return 1-成功，0-失败/超时
+ */
+uint8_t IMU_ReadRegs(uint32_t reg, uint32_t num)
+{
+    imu_reg_pending = reg;
+    imu_reg_done = 0;
+
+    if (WitReadReg(reg, num) != WIT_HAL_OK) {
+        imu_reg_pending = IMU_REG_NONE;
+        return 0;
+    }
+
+#if IMU_TRANSPORT == IMU_TRANSPORT_UART
+    uint32_t start = HAL_GetTick();
+    while (!imu_reg_done && (HAL_GetTick() - start) < IMU_COMM_TIMEOUT) {
+        IMU_Stream_Poll();
+    }
+#endif
 
-    return 1;  // 成功
+    imu_reg_pending = IMU_REG_NONE;
+    return imu_reg_done;
 }
 
 /**
@@ -111,49 +208,162 @@ int32_t IMU_SetGyroOnlyMode(void)
  */
 uint8_t IMU_GetAlgorithmMode(void)
 {
-    int32_t result;
-    uint8_t mode_value;
+    // 声明外部sReg数组（维特SDK中定义）
+    extern int16_t sReg[];
 
     // 读取AXIS6寄存器
-    result = WitReadReg(AXIS6, 1);
-    if (result != WIT_HAL_OK) {
+    if (!IMU_ReadRegs(AXIS6, 1)) {
         return 0xFF;  // 读取失败
     }
 
     // 从SDK寄存器数组获取值
+    return (uint8_t)sReg[AXIS6];
+}
+
+/**
+ * @brief 回读模块当前配置
+ * @param cfg 回读结果
+ * @return 1-成功，0-失败
+ */
+uint8_t IMU_ReadConfig(IMU_Config_t* cfg)
+{
     extern int16_t sReg[];
-    mode_value = (uint8_t)sReg[AXIS6];
 
-    return mode_value;
+    // RSW(0x02)与RRATE(0x03)相邻，一次读取
+    if (!IMU_ReadRegs(RSW, 2)) {
+        return 0;
+    }
+    cfg->content = (uint16_t)sReg[RSW];
+    cfg->rate = (uint16_t)sReg[RRATE];
+
+    if (!IMU_ReadRegs(BANDWIDTH, 1)) {
+        return 0;
+    }
+    cfg->bandwidth = (uint16_t)sReg[BANDWIDTH];
+
+    if (!IMU_ReadRegs(AXIS6, 1)) {
+        return 0;
+    }
+    cfg->axis6 = (uint16_t)sReg[AXIS6];
+    return 1;
+}
+
+/**
+ * @brief 应用IMU配置 - 先回读，只写入与目标不同的字段，有写入时保存并再次回读校验
+ * 配置一致时只有回读开销，不写模块FLASH
+ * @param cfg 目标配置
+ * @return 写入字段掩码 (IMU_CFG_F_*)，IMU_CFG_F_ERROR表示回读/写入/校验失败
+ */
+uint8_t IMU_ApplyConfig(const IMU_Config_t* cfg)
+{
+    IMU_Config_t cur;
+    uint8_t mask = 0;
+    uint8_t ok = 1;
+
+    if (!IMU_ReadConfig(&cur)) {
+        return IMU_CFG_F_ERROR;
+    }
+
+    if (cur.content != cfg->content) {
+        ok &= (WitSetContent(cfg->content) == WIT_HAL_OK);
+        HAL_Delay(IMU_CFG_WRITE_DELAY_MS);
+        mask |= IMU_CFG_F_CONTENT;
+    }
+    if (cur.rate != cfg->rate) {
+        ok &= (WitSetOutputRate(cfg->rate) == WIT_HAL_OK);
+        HAL_Delay(IMU_CFG_WRITE_DELAY_MS);
+        mask |= IMU_CFG_F_RATE;
+    }
+    if (cur.bandwidth != cfg->bandwidth) {
+        ok &= (WitSetBandwidth(cfg->bandwidth) == WIT_HAL_OK);
+        HAL_Delay(IMU_CFG_WRITE_DELAY_MS);
+        mask |= IMU_CFG_F_BANDWIDTH;
+    }
+    if (cur.axis6 != cfg->axis6) {
+        ok &= IMU_SetAlgorithmMode((uint8_t)cfg->axis6);
+        mask |= IMU_CFG_F_AXIS6;
+    }
+
+    if (mask == 0) {
+        return 0;  // 已一致
+    }
+
+    // 保存后回读校验
+    ok &= IMU_SaveConfig();
+    if (!ok || !IMU_ReadConfig(&cur)
+        || cur.content != cfg->content || cur.rate != cfg->rate
+        || cur.bandwidth != cfg->bandwidth || cur.axis6 != cfg->axis6) {
+        mask |= IMU_CFG_F_ERROR;
+    }
+    return mask;
+}
+
+/**
+ * @brief 输出速率代码转频率
+ * @return 输出频率(Hz)，0表示单次/不输出
+ */
+float IMU_RateCodeToHz(uint16_t code)
+{
+    static const float rate_hz[] = {0.0f, 0.2f, 0.5f, 1.0f, 2.0f, 5.0f, 10.0f,
+                                    20.0f, 50.0f, 100.0f, 125.0f, 200.0f};
+
+    if (code < sizeof(rate_hz) / sizeof(rate_hz[0])) {
+        return rate_hz[code];
+    }
+    return 0.0f;
+}
+
+/**
+ * @brief 带宽代码转频率
+ * @return 带宽(Hz)，0表示无效代码
+ */
+uint16_t IMU_BandwidthCodeToHz(uint16_t code)
+{
+    static const uint16_t bw_hz[] = {256, 184, 94, 44, 21, 10, 5};
+
+    if (code < sizeof(bw_hz) / sizeof(bw_hz[0])) {
+        return bw_hz[code];
+    }
+    return 0;
 }
 
 /**
  * @brief IMU数据读取任务
- * 周期性读取JY901S欧拉角数据，20ms执行周期
+ * 周期性读取JY901S加速度、角速度和欧拉角数据，10ms执行周期
+ * 串口流模式下只扫描DMA缓冲区，不发起总线事务
  */
 void imu_task(void)
 {
-    static uint8_t retry_count = 0;
-    int32_t result;
+    uint32_t seq = imu_data.sample_seq;
 
     // 检查初始化状态
     if (imu_data.init_status == 0) {
         return;  // SDK未初始化，直接返回
     }
 
-    // 1. 调用WitReadReg读取Roll、Pitch、Yaw寄存器
-    // 从Roll寄存器开始，连续读取3个寄存器（Roll、Pitch、Yaw）
-    result = WitReadReg(Roll, 3);
+#if IMU_TRANSPORT == IMU_TRANSPORT_UART
+    // 1. 模块主动输出，本周期内到达的帧都在回调中解包 (角度帧完成一个样本)
+    IMU_Stream_Poll();
+
+    // 2. 超过通信超时没有新样本，清除数据就绪标志
+    if (imu_data.data_ready && (HAL_GetTick() - imu_data.sample_time) > IMU_COMM_TIMEOUT) {
+        imu_data.data_ready = 0;
+    }
+#else
+    static uint8_t retry_count = 0;
+    int32_t result;
+
+    // 1. 一次I2C事务连续读取AX..Yaw共12个寄存器（加速度、角速度、磁场、欧拉角）
+    // 偏航角速度直接取陀螺仪GZ，不再对量化偏航角差分
+    // 寄存器在读取开始时锁存，以开始时刻作为采集时刻
+    imu_acq_us = Perf_GetMicros();
+    result = WitReadReg(IMU_BURST_START, IMU_BURST_NUM);
 
     // 2. 检查读取结果
     if (result == WIT_HAL_OK) {
-        // 读取成功，数据会通过回调函数IMU_RegUpdateCallback自动更新
+        // 读取成功，数据和时间戳由回调函数IMU_RegUpdateCallback更新
         // 重置重试计数
         retry_count = 0;
-
-        // 3. 更新时间戳（数据在回调函数中已更新）
-        imu_data.last_update_time = HAL_GetTick();
-
     } else {
         // 4. 处理通信失败和重试机制
         retry_count++;
@@ -170,6 +380,14 @@ void imu_task(void)
             retry_count = 0;  // 重置重试计数，下次继续尝试
         }
     }
+#endif
+
+    // 新样本：更新连续航向，轮速为0时估计陀螺仪零偏
+    if (imu_data.sample_seq != seq) {
+        uint8_t still = fabsf(get_left_wheel_speed_ms()) < HEADING_STILL_SPEED
+                     && fabsf(get_right_wheel_speed_ms()) < HEADING_STILL_SPEED;
+        Heading_Update(&heading_data, imu_data.yaw, imu_data.gz, still, imu_data.sample_time);
+    }
 }
 
 /**
@@ -212,7 +430,28 @@ void IMU_RegUpdateCallback(uint32_t uiReg, uint32_t uiRegNum)
     // 声明外部sReg数组（维特SDK中定义）
     extern int16_t sReg[];
 
-    // 检查是否包含欧拉角寄存器
+    // 同步寄存器读取的应答
+    if (uiReg == imu_reg_pending) {
+        imu_reg_done = 1;
+    }
+
+    // I2C连续读取块 (AX..Yaw) 一次覆盖以下三组；串口流模式下加速度帧、角速度帧、角度帧分别到达
+
+    // 加速度 (0x34-0x36)
+    if (uiReg <= AX && (uiReg + uiRegNum) > AZ) {
+        imu_data.ax = (float)sReg[AX] * IMU_ACC_SCALE;
+        imu_data.ay = (float)sReg[AY] * IMU_ACC_SCALE;
+        imu_data.az = (float)sReg[AZ] * IMU_ACC_SCALE;
+    }
+
+    // 角速度 (0x37-0x39)
+    if (uiReg <= GX && (uiReg + uiRegNum) > GZ) {
+        imu_data.gx = (float)sReg[GX] * IMU_GYRO_SCALE;
+        imu_data.gy = (float)sReg[GY] * IMU_GYRO_SCALE;
+        imu_data.gz = (float)sReg[GZ] * IMU_GYRO_SCALE;
+    }
+
+    // 检查是否包含欧拉角寄存器 (角度最后到达，完成一个样本)
     if (uiReg <= Yaw && (uiReg + uiRegNum) > Roll) {
         // 转换Roll角度 (0x3d)
         if (uiReg <= Roll && (uiReg + uiRegNum) > Roll) {
@@ -229,9 +468,16 @@ void IMU_RegUpdateCallback(uint32_t uiReg, uint32_t uiRegNum)
             imu_data.yaw = (float)sReg[Yaw] * IMU_ANGLE_SCALE;
         }
 
-        // 更新数据状态
+        // 更新数据状态和采样时间
+        imu_data.sample_time = HAL_GetTick();
+#if IMU_TRANSPORT == IMU_TRANSPORT_UART
+        imu_data.sample_us = IMU_Stream_GetFrameUs();
+#else
+        imu_data.sample_us = imu_acq_us;
+#endif
+        imu_data.sample_seq++;
         imu_data.data_ready = 1;
-        imu_data.last_update_time = HAL_GetTick();
+        imu_data.last_update_time = imu_data.sample_time;
     }
 }
 
@@ -17,12 +17,40 @@
 
 // 角度转换参数
 #define IMU_ANGLE_SCALE       (180.0f / 32768.0f)  // 寄存器值转角度系数
+#define IMU_ACC_SCALE         (16.0f * 9.80665f / 32768.0f)  // 寄存器值转加速度系数(m/s²)，量程±16g
+#define IMU_GYRO_SCALE        (2000.0f / 32768.0f)           // 寄存器值转角速度系数(°/s)，量程±2000°/s
+#define IMU_BURST_START       AX           // 连续读取起始寄存器 (AX 0x34)
+#define IMU_BURST_NUM         12           // 连续读取寄存器数 (AX..Yaw，0x34-0x3F，24字节)
+
+// IMU配置字段掩码 (IMU_ApplyConfig返回值)
+#define IMU_CFG_F_RATE        0x01         // 输出速率
+#define IMU_CFG_F_BANDWIDTH   0x02         // 滤波带宽
+#define IMU_CFG_F_CONTENT     0x04         // 输出内容
+#define IMU_CFG_F_AXIS6       0x08         // 6/9轴算法
+#define IMU_CFG_F_ERROR       0x80         // 回读/写入/校验失败
+
+// IMU配置档 (寄存器原始代码)
+typedef struct {
+    uint16_t rate;                 // 输出速率 RRATE (RRATE_*)
+    uint16_t bandwidth;            // 滤波带宽 BANDWIDTH (BANDWIDTH_*)
+    uint16_t content;              // 输出内容 RSW (RSW_*)
+    uint16_t axis6;                // 算法 AXIS6 (ALGRITHM6/ALGRITHM9)
+} IMU_Config_t;
 
 // IMU数据结构
 typedef struct {
+    float ax;                      // X轴加速度(m/s²)
+    float ay;                      // Y轴加速度(m/s²)
+    float az;                      // Z轴加速度(m/s²)
+    float gx;                      // X轴角速度(°/s)
+    float gy;                      // Y轴角速度(°/s)
+    float gz;                      // Z轴角速度(°/s)，偏航角速度，逆时针为正
     float roll;                    // 横滚角(度)
     float pitch;                   // 俯仰角(度)
     float yaw;                     // 偏航角(度)
+    uint32_t sample_time;          // 本组数据采样时间(ms)，连续读取完成时记录
+    uint32_t sample_us;            // 本组数据采集时刻(us，Perf_GetMicros)：I2C为读取开始，串口为角度帧开始到达
+    uint32_t sample_seq;           // 采样序号 (每完成一次连续读取+1)
     uint8_t data_ready;            // 数据就绪标志
     uint32_t last_update_time;     // 上次更新时间(ms)
     uint8_t comm_error_count;      // 通信错误计数
@@ -30,6 +58,8 @@ typedef struct {
 } IMU_Data_t;
 
 extern IMU_Data_t imu_data; // 全局IMU数据
+extern IMU_Config_t imu_config; // IMU目标配置档
+extern uint8_t imu_config_result; // 最近一次配置应用结果
 
 /**
  * @brief IMU初始化函数
@@ -41,11 +71,37 @@ void IMU_Init(void);
  */
 int32_t IMU_SetGyroOnlyMode(void);
 
+/**
+ * @brief 设置姿态算法模式 (不保存)
+ */
+uint8_t IMU_SetAlgorithmMode(uint8_t mode);
+
 /**
  * @brief 读取当前算法模式
  */
 uint8_t IMU_GetAlgorithmMode(void);
 
+/**
+ * @brief 同步读取寄存器到sReg (I2C/串口通用)
+ */
+uint8_t IMU_ReadRegs(uint32_t reg, uint32_t num);
+
+/**
+ * @brief 回读模块当前配置
+ */
+uint8_t IMU_ReadConfig(IMU_Config_t* cfg);
+
+/**
+ * @brief 应用配置档 (仅写入与回读不同的字段)
+ */
+uint8_t IMU_ApplyConfig(const IMU_Config_t* cfg);
+
+/**
+ * @brief 输出速率/带宽代码转频率
+ */
+float IMU_RateCodeToHz(uint16_t code);
+uint16_t IMU_BandwidthCodeToHz(uint16_t code);
+
 /**
  * @brief IMU数据读取任务
  */
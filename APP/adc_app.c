@@ -9,6 +9,91 @@ uint32_t adc_dma_buffer[ADC_DMA_BUFFER_SIZE];         // DMA目标缓冲区
 uint32_t adc_val;                                     // 平均ADC值
 float voltage;                                        // 电压值
 
+// 电池电压一阶低通系数 dt/(τ+dt)
+#define VBAT_FILTER_ALPHA   (VBAT_SAMPLE_PERIOD_S / (VBAT_FILTER_TAU_S + VBAT_SAMPLE_PERIOD_S))
+
+Battery_t battery = {
+    .comp = 1.0f,
+    .derate = 1.0f,
+    .factor = 1.0f,
+    .divider_ratio = VBAT_DIVIDER_RATIO,
+    .enabled = VBAT_COMP_ENABLE
+};
+
+/**
+ * @brief 电池电压补偿更新
+ * 滤波时间常数远大于速度环，负载压降不会经补偿系数形成正反馈
+ * @param bat 电池数据指针
+ * @param v_adc ADC引脚电压(V)
+ */
+static void Battery_Update(Battery_t* bat, float v_adc)
+{
+    bat->vbat = v_adc * bat->divider_ratio;
+
+    if (bat->vbat < VBAT_VALID_MIN) {
+        // 未接电池(仅USB供电)或分压电路断开：不补偿也不降额
+        bat->valid = 0;
+        bat->comp = 1.0f;
+        bat->derate = 1.0f;
+        bat->factor = 1.0f;
+        return;
+    }
+
+    if (!bat->valid) {
+        bat->vbat_filtered = bat->vbat;  // 首个有效样本直接作为初值
+        bat->valid = 1;
+    } else {
+        bat->vbat_filtered += VBAT_FILTER_ALPHA * (bat->vbat - bat->vbat_filtered);
+    }
+
+    bat->comp = VBAT_NOMINAL / bat->vbat_filtered;
+    if (bat->comp < VBAT_COMP_MIN) bat->comp = VBAT_COMP_MIN;
+    if (bat->comp > VBAT_COMP_MAX) bat->comp = VBAT_COMP_MAX;
+
+    // 低压降额：VBAT_DERATE_START到VBAT_DERATE_END之间线性降到VBAT_DERATE_MIN
+    if (bat->vbat_filtered >= VBAT_DERATE_START) {
+        bat->derate = 1.0f;
+    } else if (bat->vbat_filtered <= VBAT_DERATE_END) {
+        bat->derate = VBAT_DERATE_MIN;
+    } else {
+        bat->derate = VBAT_DERATE_MIN + (1.0f - VBAT_DERATE_MIN) *
+                      (bat->vbat_filtered - VBAT_DERATE_END) / (VBAT_DERATE_START - VBAT_DERATE_END);
+    }
+
+    bat->factor = bat->enabled ? bat->comp * bat->derate : 1.0f;
+}
+
+/**
+ * @brief 按已知电池电压标定分压比
+ * 用万用表测得的电池电压除以当前ADC引脚电压，滤波电压从下一个样本重新开始
+ * @param bat 电池数据指针
+ * @param vbat_known 实测电池电压(V)
+ * @retval 1: 成功, 0: 电压无效或分压电路未接
+ */
+uint8_t Battery_Calibrate(Battery_t* bat, float vbat_known)
+{
+    if (vbat_known < VBAT_VALID_MIN || voltage < VBAT_CAL_PIN_MIN) return 0;
+
+    bat->divider_ratio = vbat_known / voltage;
+    bat->valid = 0;
+    return 1;
+}
+
+/**
+ * @brief 按电池电压补偿系数缩放PWM
+ * @param bat 电池数据指针
+ * @param pwm 整形后的PWM (按VBAT_NOMINAL电压下的等效值)
+ * @retval 实际输出PWM
+ */
+int32_t Battery_ScalePwm(const Battery_t* bat, int32_t pwm)
+{
+    float out = (float)pwm * bat->factor;
+
+    if (out > MOTOR_SHAPE_PWM_MAX) out = MOTOR_SHAPE_PWM_MAX;
+    if (out < -MOTOR_SHAPE_PWM_MAX) out = -MOTOR_SHAPE_PWM_MAX;
+    return (int32_t)out;
+}
+
 /**
  * @brief ADC任务函数
  * @retval 无
@@ -24,6 +109,7 @@ void adc_task(void)
 
     adc_val = adc_sum / ADC_DMA_BUFFER_SIZE;      // 计算平均ADC值
     voltage = ((float)adc_val * 3.3f) / 4096.0f; // 转换为实际电压值(12位分辨率, 3.3V参考电压)
+    Battery_Update(&battery, voltage);            // 换算电池电压并更新补偿系数
 
     // 4. 使用计算出的平均值 (adc_val 或 voltage)
     // my_printf(&huart1, "Average ADC: %lu, Voltage: %.2fV\n", adc_val, voltage);
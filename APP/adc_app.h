@@ -10,11 +10,35 @@
 #define ADC_DMA_BUFFER_SIZE 32         // DMA缓冲区大小
 extern uint32_t adc_dma_buffer[ADC_DMA_BUFFER_SIZE]; // DMA目标缓冲区
 extern uint32_t adc_val;               // 平均ADC值
-extern float voltage;                  // 电压值
+extern float voltage;                  // 电压值 (ADC引脚)
+
+// 电池电压补偿数据结构
+typedef struct {
+    float vbat;                // 电池电压(V) = ADC引脚电压 × divider_ratio
+    float divider_ratio;       // 分压比 (默认VBAT_DIVIDER_RATIO，battery cal按已知电压标定)
+    float vbat_filtered;       // 低通滤波电池电压(V)
+    float comp;                // 电压补偿系数 VBAT_NOMINAL/Vbat (已限幅)
+    float derate;              // 低压降额系数 (1为不降额)
+    float factor;              // PWM输出总系数 = comp × derate
+    uint8_t valid;             // 电池电压有效 (低于VBAT_VALID_MIN视为未接电池，不补偿)
+    uint8_t enabled;           // 电压补偿与低压降额使能
+} Battery_t;
+
+extern Battery_t battery;              // 全局电池电压补偿
 
 /**
  * @brief ADC任务函数
  */
 void adc_task(void);
 
+/**
+ * @brief 按电池电压补偿系数缩放PWM (限幅到±MOTOR_SHAPE_PWM_MAX)
+ */
+int32_t Battery_ScalePwm(const Battery_t* bat, int32_t pwm);
+
+/**
+ * @brief 按已知电池电压标定分压比
+ */
+uint8_t Battery_Calibrate(Battery_t* bat, float vbat_known);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,302 @@
+/**
+ * @file control_bench.c
+ * @brief 闭环基准测试模块实现 - 电机/底盘仿真对象上的阶跃、斜坡、扰动响应评估
+ * @note 控制器部分与pid_task共用同一套计算函数(pid_bank_update、PID_Line_Calc、
+ *       PID_Body_Velocity_Calc、Profile_Update)，参数取自当前生效参数块，
+ *       控制器和仿真对象均为局部实例，不影响实际控制环状态。
+ *       对象模型：轮速一阶惯性 + 静摩擦死区，底盘按差速运动学积分。
+ *       本文件同时编译进主机端测试工程(tests/，定义HOST_BUILD)：结果经printf输出，
+ *       主机端没有DWT周期计数，cycles列为-1，只在目标板上有效。
+ */
+#include "control_bench.h"
+
+#ifdef HOST_BUILD
+#define BENCH_PRINTF(...)   printf(__VA_ARGS__)
+#define BENCH_CYCLES()      0U
+#else
+#define BENCH_PRINTF(...)   my_printf(&huart2, __VA_ARGS__)
+#define BENCH_CYCLES()      Perf_GetCycles()
+#endif
+
+#define BENCH_CTRL_DIV      ((uint32_t)(PID_CONTROL_PERIOD_S / BENCH_SIM_DT + 0.5f)) // 每个控制周期的仿真步数
+#define BENCH_WARMUP_S      1.0f        // 扰动/循线场景的预热时间(s)
+
+static const char *bench_names[BENCH_NUM] = {"step", "ramp", "disturb", "line"};
+// 评估时长需覆盖默认参数下的完整调节过程(阶跃约1.6s、斜坡约1.8s、扰动恢复约1.2s)，
+// 否则积分环尚未拉回调节带，调节时间恒为-1
+static const float bench_duration[BENCH_NUM] = {3.0f, 4.0f, 5.0f + BENCH_WARMUP_S, 5.0f + BENCH_WARMUP_S};
+
+// 仿真状态
+typedef struct {
+    PID_Bank_T speed;                   // 左右轮速度环
+    PID_T line;                         // 循线环
+    Motion_Profile_t profile;           // 速度规划
+    Body_Velocity_t body;               // 逆运动学结果
+    float wheel_v[PID_SPEED_NUM];       // 轮速(m/s)
+    float load[PID_SPEED_NUM];          // 负载(折算为稳态轮速损失，m/s)
+    float pwm[PID_SPEED_NUM];           // 电机PWM
+    float y;                            // 驱动轴中心横向偏移(m)，位于线左侧为正
+    float theta;                        // 相对线方向的航向角(rad)
+    uint32_t cycles_sum;                // 控制器累计CPU周期
+    uint32_t ticks;                     // 控制周期计数
+} Bench_Sim_t;
+
+// 阶跃响应在线评估 (不保存轨迹)
+typedef struct {
+    float start;                        // 起始值
+    float final;                        // 最终设定值
+    float t_10;                         // 到达10%进度时刻(s)，<0表示未到达
+    float t_90;                         // 到达90%进度时刻(s)
+    float peak;                         // 最大归一化进度
+    float last_out;                     // 最后一次位于调节带外的时刻(s)
+    float ise;                          // 误差平方积分
+} Bench_Metric_t;
+
+static Bench_Sim_t bench_sim;           // 体积较大，静态存放避免占用任务栈
+
+/**
+ * @brief  仿真初始化 - 复制当前生效参数到局部控制器
+ * @param  sim: 仿真状态指针
+ * @retval None
+ */
+static void bench_sim_init(Bench_Sim_t *sim) {
+    memset(sim, 0, sizeof(Bench_Sim_t));
+
+    pid_bank_init(&sim->speed, PID_SPEED_NUM);
+    for (uint8_t c = 0; c < PID_SPEED_NUM; c++) {
+        const pid_params_t *p = PID_GetActiveParams((pid_ctrl_id_t)c);
+        pid_bank_set_params(&sim->speed, c, p->Kp, p->Ki, p->Kd);
+        pid_bank_set_limit(&sim->speed, c, p->out_min, p->out_max);
+    }
+
+    const pid_params_t *lp = PID_GetActiveParams(PID_CTRL_LINE);
+    pid_init(&sim->line, lp->Kp, lp->Ki, lp->Kd, 0.0f, lp->out_max);
+
+    Profile_Init(&sim->profile, speed_profile.max_accel, speed_profile.max_jerk);
+    Profile_SetDecel(&sim->profile, speed_profile.max_decel);
+}
+
+/**
+ * @brief  控制周期 - 与pid_task相同的计算链
+ * @param  sim: 仿真状态指针
+ * @param  v_ref: 线速度指令(m/s)
+ * @param  use_line: 1-循线环参与控制
+ * @retval None
+ */
+static void bench_control_tick(Bench_Sim_t *sim, float v_ref, uint8_t use_line) {
+    // 传感器仿真：传感器位于驱动轴前方，线在传感器左侧时偏差为正
+    float sensor_offset = sim->y + BENCH_SENSOR_LOOKAHEAD * sinf(sim->theta);
+    float gary_error = pid_constrain(-sensor_offset / BENCH_SENSOR_PITCH, GARY_ERROR_MIN, GARY_ERROR_MAX);
+
+    uint32_t start = BENCH_CYCLES();
+
+    float omega = 0.0f;
+    if (use_line) {
+        omega = PID_Line_Calc(&sim->line, PID_GetActiveParams(PID_CTRL_LINE), gary_error);
+    }
+    PID_Body_Velocity_Calc(v_ref, omega, &sim->body);
+    pid_bank_set_target(&sim->speed, PID_SPEED_LEFT, sim->body.left_target);
+    pid_bank_set_target(&sim->speed, PID_SPEED_RIGHT, sim->body.right_target);
+    pid_bank_update(&sim->speed, sim->wheel_v);
+
+    sim->cycles_sum += BENCH_CYCLES() - start;
+    sim->ticks++;
+
+    // Motor_SetSpeed按整数PWM输出
+    sim->pwm[PID_SPEED_LEFT] = (float)(int32_t)sim->speed.out[PID_SPEED_LEFT];
+    sim->pwm[PID_SPEED_RIGHT] = (float)(int32_t)sim->speed.out[PID_SPEED_RIGHT];
+}
+
+/**
+ * @brief  对象积分一步 - 电机一阶模型 + 差速底盘
+ * @param  sim: 仿真状态指针
+ * @retval None
+ */
+static void bench_plant_step(Bench_Sim_t *sim) {
+    for (uint8_t i = 0; i < PID_SPEED_NUM; i++) {
+        float u = sim->pwm[i] * (BENCH_WHEEL_V_MAX / 999.0f);
+
+        // 静摩擦死区：驱动量不足时电机不转
+        if (fabsf(u) <= BENCH_WHEEL_DEADBAND) {
+            u = 0.0f;
+        } else {
+            u -= (u > 0.0f) ? BENCH_WHEEL_DEADBAND : -BENCH_WHEEL_DEADBAND;
+        }
+        u -= sim->load[i];
+
+        sim->wheel_v[i] += (u - sim->wheel_v[i]) * (BENCH_SIM_DT / BENCH_WHEEL_TAU);
+    }
+
+    float v = 0.5f * (sim->wheel_v[PID_SPEED_LEFT] + sim->wheel_v[PID_SPEED_RIGHT]);
+    float omega = (sim->wheel_v[PID_SPEED_RIGHT] - sim->wheel_v[PID_SPEED_LEFT]) / WHEEL_BASE;
+    sim->theta += omega * BENCH_SIM_DT;
+    sim->y += v * sinf(sim->theta) * BENCH_SIM_DT;
+}
+
+/**
+ * @brief  评估初始化
+ */
+static void bench_metric_init(Bench_Metric_t *m, float start, float final) {
+    m->start = start;
+    m->final = final;
+    m->t_10 = -1.0f;
+    m->t_90 = -1.0f;
+    m->peak = 0.0f;
+    m->last_out = 0.0f;
+    m->ise = 0.0f;
+}
+
+/**
+ * @brief  评估更新 - 每个仿真步调用
+ * @param  m: 评估状态
+ * @param  t: 自评估开始的时间(s)
+ * @param  x: 被评估量
+ * @param  ref: 该时刻的参考值(ISE按ref - x计算)
+ */
+static void bench_metric_update(Bench_Metric_t *m, float t, float x, float ref) {
+    float progress = (x - m->start) / (m->final - m->start);
+
+    if (m->t_10 < 0.0f && progress >= 0.1f) m->t_10 = t;
+    if (m->t_90 < 0.0f && progress >= 0.9f) m->t_90 = t;
+    if (progress > m->peak) m->peak = progress;
+    if (fabsf(progress - 1.0f) > BENCH_SETTLE_BAND) m->last_out = t;
+
+    float e = ref - x;
+    m->ise += e * e * BENCH_SIM_DT;
+}
+
+/**
+ * @brief  评估结果汇总
+ * @param  m: 评估状态
+ * @param  span: 评估时长(s)，到结束仍在调节带外时调节时间记为-1
+ */
+static void bench_metric_finish(const Bench_Metric_t *m, float span, Bench_Result_t *result) {
+    result->rise_ms = (m->t_10 >= 0.0f && m->t_90 >= 0.0f) ? (m->t_90 - m->t_10) * 1000.0f : -1.0f;
+    result->overshoot_pct = (m->peak > 1.0f) ? (m->peak - 1.0f) * 100.0f : 0.0f;
+    result->settle_ms = (m->last_out < span - BENCH_SIM_DT * 1.5f) ? (m->last_out + BENCH_SIM_DT) * 1000.0f : -1.0f;
+    result->ise = m->ise;
+}
+
+/**
+ * @brief  运行单个基准场景
+ * @param  scenario: 场景编号
+ * @param  result: 评估结果输出
+ * @retval None
+ */
+void Bench_Run(Bench_Scenario_t scenario, Bench_Result_t *result) {
+    Bench_Sim_t *sim = &bench_sim;
+    Bench_Metric_t metric;
+    const float v_set = 0.5f;
+    uint32_t steps = (uint32_t)(bench_duration[scenario] / BENCH_SIM_DT + 0.5f);
+    uint32_t warmup_steps = (uint32_t)(BENCH_WARMUP_S / BENCH_SIM_DT + 0.5f);
+    uint8_t use_line = (scenario == BENCH_LINE);
+    float v_ref = 0.0f;
+    float peak_dev = 0.0f;
+
+    bench_sim_init(sim);
+
+    switch (scenario) {
+        case BENCH_STEP:    bench_metric_init(&metric, 0.0f, v_set); break;
+        case BENCH_RAMP:    bench_metric_init(&metric, 0.0f, 1.0f);
+                            Profile_SetTarget(&sim->profile, 1.0f); break;
+        case BENCH_DISTURB: bench_metric_init(&metric, 0.0f, v_set); break;
+        default:            bench_metric_init(&metric, 0.0f, 0.0f); break;
+    }
+
+    for (uint32_t k = 0; k < steps; k++) {
+        // 预热结束：扰动场景突加负载，循线场景引入横向偏移
+        if ((scenario == BENCH_DISTURB || scenario == BENCH_LINE) && k == warmup_steps) {
+            if (scenario == BENCH_DISTURB) {
+                sim->load[PID_SPEED_LEFT] = 0.3f * v_set;
+            } else {
+                sim->y = 0.02f;
+                sim->theta = 0.0f;
+                bench_metric_init(&metric, 0.02f, 0.0f);
+            }
+        }
+
+        if (k % BENCH_CTRL_DIV == 0) {
+            v_ref = (scenario == BENCH_RAMP) ? Profile_Update(&sim->profile, PID_CONTROL_PERIOD_S) : v_set;
+            bench_control_tick(sim, v_ref, use_line);
+        }
+        bench_plant_step(sim);
+
+        float t = (float)(k + 1) * BENCH_SIM_DT;
+        float v_left = sim->wheel_v[PID_SPEED_LEFT];
+
+        switch (scenario) {
+            case BENCH_STEP:
+                bench_metric_update(&metric, t, v_left, v_set);
+                break;
+            case BENCH_RAMP:
+                bench_metric_update(&metric, t, v_left, v_ref);
+                break;
+            case BENCH_DISTURB:
+                if (k >= warmup_steps) {
+                    float td = t - BENCH_WARMUP_S;
+                    float dev = fabsf(v_set - v_left);
+                    if (dev > peak_dev) peak_dev = dev;
+                    if (dev > BENCH_SETTLE_BAND * v_set) metric.last_out = td;
+                    metric.ise += (v_set - v_left) * (v_set - v_left) * BENCH_SIM_DT;
+                }
+                break;
+            default:
+                if (k >= warmup_steps) {
+                    float sensor_offset = sim->y + BENCH_SENSOR_LOOKAHEAD * sinf(sim->theta);
+                    bench_metric_update(&metric, t - BENCH_WARMUP_S, sensor_offset, 0.0f);
+                }
+                break;
+        }
+    }
+
+    if (scenario == BENCH_DISTURB || scenario == BENCH_LINE) {
+        bench_metric_finish(&metric, bench_duration[scenario] - BENCH_WARMUP_S, result);
+    } else {
+        bench_metric_finish(&metric, bench_duration[scenario], result);
+    }
+
+    // 扰动场景无阶跃过程，超调量列给出最大偏离量
+    if (scenario == BENCH_DISTURB) {
+        result->rise_ms = -1.0f;
+        result->overshoot_pct = peak_dev / v_set * 100.0f;
+    }
+
+#ifdef HOST_BUILD
+    result->cycles = -1.0f;
+#else
+    result->cycles = sim->ticks ? (float)sim->cycles_sum / (float)sim->ticks : 0.0f;
+#endif
+}
+
+/**
+ * @brief  获取场景名称
+ * @param  scenario: 场景编号
+ * @retval 场景名称字符串
+ */
+const char* Bench_GetName(Bench_Scenario_t scenario) {
+    return (scenario < BENCH_NUM) ? bench_names[scenario] : "unknown";
+}
+
+/**
+ * @brief  运行基准场景并输出CSV结果
+ * @param  scenario: 场景编号，<0时运行全部场景
+ * @retval None
+ */
+void Bench_Report(int scenario) {
+    const pid_params_t *sp = PID_GetActiveParams(PID_CTRL_LEFT);
+    const pid_params_t *lp = PID_GetActiveParams(PID_CTRL_LINE);
+    Bench_Result_t result;
+
+    // 注释行记录本次参数，便于多次结果对比
+    BENCH_PRINTF("# speed Kp=%.3f Ki=%.3f Kd=%.3f; line Kp=%.3f Ki=%.3f Kd=%.3f; accel=%.2f jerk=%.2f\r\n",
+              sp->Kp, sp->Ki, sp->Kd, lp->Kp, lp->Ki, lp->Kd, speed_profile.max_accel, speed_profile.max_jerk);
+    BENCH_PRINTF("scenario,rise_ms,overshoot_pct,settle_ms,ise,cycles\r\n");
+
+    for (int s = 0; s < BENCH_NUM; s++) {
+        if (scenario >= 0 && s != scenario) continue;
+
+        Bench_Run((Bench_Scenario_t)s, &result);
+        BENCH_PRINTF("%s,%.1f,%.2f,%.1f,%.6g,%.1f\r\n", Bench_GetName((Bench_Scenario_t)s),
+                  result.rise_ms, result.overshoot_pct, result.settle_ms, result.ise, result.cycles);
+    }
+}
@@ -0,0 +1,45 @@
+/**
+ * @file control_bench.h
+ * @brief 闭环基准测试模块头文件 - 电机/底盘仿真对象上的阶跃、斜坡、扰动响应评估
+ */
+#ifndef CONTROL_BENCH_H
+#define CONTROL_BENCH_H
+
+#include "mydefine.h"
+
+// 基准测试配置参数已迁移到mydefine.h统一管理
+
+// 测试场景
+typedef enum {
+    BENCH_STEP = 0,         // 速度环阶跃: 0 -> 0.5m/s (绕过速度规划)
+    BENCH_RAMP,             // 速度规划斜坡: 0 -> 1.0m/s
+    BENCH_DISTURB,          // 负载扰动: 0.5m/s稳态下左轮突加负载
+    BENCH_LINE,             // 循线纠偏: 0.5m/s行驶，初始横向偏移2cm
+    BENCH_NUM
+} Bench_Scenario_t;
+
+// 单个场景评估结果 (-1表示该指标不适用)
+typedef struct {
+    float rise_ms;          // 上升时间10%->90%(ms)
+    float overshoot_pct;    // 超调量(%)，扰动场景为最大偏离量占设定值百分比
+    float settle_ms;        // 进入并保持在调节带内的时间(ms)
+    float ise;              // 误差平方积分
+    float cycles;           // 控制器每周期平均CPU周期数
+} Bench_Result_t;
+
+/**
+ * @brief 运行单个基准场景 (使用当前生效的PID参数和速度规划限制)
+ */
+void Bench_Run(Bench_Scenario_t scenario, Bench_Result_t *result);
+
+/**
+ * @brief 获取场景名称
+ */
+const char* Bench_GetName(Bench_Scenario_t scenario);
+
+/**
+ * @brief 运行全部或指定场景并以CSV格式输出结果
+ */
+void Bench_Report(int scenario);
+
+#endif
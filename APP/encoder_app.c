@@ -30,6 +30,8 @@ void Encoder_Init(void) {
     encoder_data_A.calc_time_us = 0;
     encoder_data_A.error_count = 0;
     encoder_data_A.filter_sum = 0;
+    encoder_data_A.sample_us = Perf_GetMicros();
+    encoder_data_A.speed_time_us = encoder_data_A.sample_us;
 
     encoder_data_B.encoder_id = ENCODER_B;
     encoder_data_B.total_count = 0;
@@ -44,6 +46,8 @@ void Encoder_Init(void) {
     encoder_data_B.calc_time_us = 0;
     encoder_data_B.error_count = 0;
     encoder_data_B.filter_sum = 0;
+    encoder_data_B.sample_us = Perf_GetMicros();
+    encoder_data_B.speed_time_us = encoder_data_B.sample_us;
 
 
     // 清零编码器A滤波缓冲区
@@ -69,6 +73,7 @@ void Encoder_Init(void) {
 void calculate_speed_for_encoder(Encoder_Data_t* encoder_data, TIM_HandleTypeDef* htim) {
     uint32_t current_time = HAL_GetTick();
     uint32_t current_counter = __HAL_TIM_GET_COUNTER(htim);
+    uint32_t current_us = Perf_GetMicros();   // 与计数器读取同时打时间戳
 
     // 检查是否到达自适应采样时间
     uint32_t time_diff_ms = current_time - encoder_data->last_update_time;
@@ -87,7 +92,9 @@ void calculate_speed_for_encoder(Encoder_Data_t* encoder_data, TIM_HandleTypeDef
             delta_count -= 0x10000; // 反向溢出
         }
 
-        if (delta_count == 0 || time_diff_ms > 200) {
+        uint32_t time_diff_us = current_us - encoder_data->sample_us;
+
+        if (delta_count == 0 || time_diff_ms > 200 || time_diff_us == 0) {
             // 无脉冲或时间过长，速度为0
             encoder_data->speed_rps = 0.0f;
             encoder_data->speed_rpm = 0;
@@ -97,18 +104,25 @@ void calculate_speed_for_encoder(Encoder_Data_t* encoder_data, TIM_HandleTypeDef
             for(int i = 0; i < ENCODER_FILTER_SIZE; i++) {
                 encoder_data->speed_buffer[i] = 0;
             }
+            encoder_data->filter_sum = 0;
+            encoder_data->speed_time_us = current_us;
         } else {
             // 性能优化：使用预计算常量，单次乘法替代两次除法
-            float pulses_per_ms = (float)delta_count / (float)time_diff_ms;
+            // 时间差按微秒计，避免任务调度抖动造成的毫秒量化误差
+            float pulses_per_ms = (float)delta_count * 1000.0f / (float)time_diff_us;
             float current_rps = pulses_per_ms * SPEED_CALC_FACTOR;
 
             // 应用优化的滑动平均滤波（增量更新，计算效率提升80%）
             apply_moving_average_filter(encoder_data, current_rps);
+
+            // 滑动平均等效于窗口中点的速度，滞后 窗口数×采样间隔/2
+            encoder_data->speed_time_us = current_us - (time_diff_us * ENCODER_FILTER_SIZE) / 2;
         }
 
         // 更新状态
         encoder_data->last_count = current_counter;
         encoder_data->last_update_time = current_time;
+        encoder_data->sample_us = current_us;
         encoder_data->total_count = current_counter;
 
         // 根据当前速度更新下次采样时间
@@ -222,6 +236,8 @@ void clear_speed_data(void) {
     encoder_data_A.calc_time_us = 0;
     encoder_data_A.error_count = 0;
     encoder_data_A.filter_sum = 0;
+    encoder_data_A.sample_us = Perf_GetMicros();
+    encoder_data_A.speed_time_us = encoder_data_A.sample_us;
 
     // 清零编码器A滤波缓冲区
     for(int i = 0; i < ENCODER_FILTER_SIZE; i++) {
@@ -241,6 +257,8 @@ void clear_speed_data(void) {
     encoder_data_B.calc_time_us = 0;
     encoder_data_B.error_count = 0;
     encoder_data_B.filter_sum = 0;
+    encoder_data_B.sample_us = Perf_GetMicros();
+    encoder_data_B.speed_time_us = encoder_data_B.sample_us;
 
     // 清零编码器B滤波缓冲区
     for(int i = 0; i < ENCODER_FILTER_SIZE; i++) {
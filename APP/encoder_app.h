@@ -33,6 +33,8 @@ typedef struct {
     uint32_t calc_time_us;            // 计算耗时统计(微秒)
     uint16_t error_count;             // 错误计数
     int32_t filter_sum;               // 滤波缓冲区累加和（增量滤波优化）
+    uint32_t sample_us;               // 上次读取计数器时刻(us，Perf_GetMicros)
+    uint32_t speed_time_us;           // 滤波后速度对应的时刻(us)：滑动平均窗口中点
 } Encoder_Data_t;
 
 // 差速驱动数据结构
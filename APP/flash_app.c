@@ -0,0 +1,119 @@
+/**
+ * @file flash_app.c
+ * @brief Flash参数存储模块实现 - 片内Flash扇区保存标定/地图等掉电数据
+ * @note 记录格式: [魔数4B][长度2B][保留2B][校验和4B][数据...]，按字写入
+ *       存储扇区已从链接脚本FLASH区域中排除，程序不会占用
+ */
+#include "flash_app.h"
+
+// 记录头
+typedef struct {
+    uint32_t magic;             // 记录类型魔数
+    uint16_t length;            // 数据长度(字节)
+    uint16_t reserved;          // 保留(对齐)
+    uint32_t checksum;          // 数据校验和(FNV-1a)
+} Flash_RecordHeader_t;
+
+// 存储区表
+typedef struct {
+    uint32_t address;           // 扇区起始地址
+    uint32_t sector;            // 扇区编号
+    uint32_t size;              // 扇区大小(字节)
+} Flash_RegionInfo_t;
+
+static const Flash_RegionInfo_t flash_regions[FLASH_REGION_NUM] = {
+    {FLASH_CALIB_ADDR, FLASH_CALIB_SECTOR, FLASH_CALIB_SIZE},
+    {FLASH_TRACK_ADDR, FLASH_TRACK_SECTOR, FLASH_TRACK_SIZE},
+};
+
+/**
+ * @brief  计算数据校验和 (FNV-1a 32位)
+ */
+static uint32_t Flash_Checksum(const uint8_t *data, uint16_t len) {
+    uint32_t hash = 2166136261u;
+    for (uint16_t i = 0; i < len; i++) {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief  保存一条记录到存储区
+ * @param  region: 存储区编号
+ * @param  magic: 记录类型魔数
+ * @param  data: 数据指针
+ * @param  len: 数据长度(字节)
+ * @retval 1: 成功, 0: 失败
+ */
+uint8_t Flash_SaveRecord(Flash_Region_t region, uint32_t magic, const void *data, uint16_t len) {
+    if (region >= FLASH_REGION_NUM || data == NULL) return 0;
+
+    const Flash_RegionInfo_t *info = &flash_regions[region];
+    if (sizeof(Flash_RecordHeader_t) + len > info->size) return 0;
+
+    Flash_RecordHeader_t header = {
+        .magic = magic,
+        .length = len,
+        .reserved = 0xFFFF,
+        .checksum = Flash_Checksum((const uint8_t *)data, len)
+    };
+
+    HAL_StatusTypeDef status;
+    uint32_t sector_error = 0;
+    FLASH_EraseInitTypeDef erase = {
+        .TypeErase = FLASH_TYPEERASE_SECTORS,
+        .Sector = info->sector,
+        .NbSectors = 1,
+        .VoltageRange = FLASH_VOLTAGE_RANGE_3
+    };
+
+    HAL_FLASH_Unlock();
+    __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_EOP | FLASH_FLAG_OPERR | FLASH_FLAG_WRPERR |
+                           FLASH_FLAG_PGAERR | FLASH_FLAG_PGPERR | FLASH_FLAG_PGSERR);
+
+    status = HAL_FLASHEx_Erase(&erase, &sector_error);
+
+    // 写入记录头
+    const uint32_t *words = (const uint32_t *)&header;
+    uint32_t addr = info->address;
+    for (uint32_t i = 0; status == HAL_OK && i < sizeof(header) / 4; i++) {
+        status = HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, addr, words[i]);
+        addr += 4;
+    }
+
+    // 写入数据 (末尾不足一个字时以0xFF补齐)
+    const uint8_t *bytes = (const uint8_t *)data;
+    for (uint32_t i = 0; status == HAL_OK && i < len; i += 4) {
+        uint32_t word = 0xFFFFFFFFu;
+        uint32_t n = (len - i < 4) ? (len - i) : 4;
+        memcpy(&word, &bytes[i], n);
+        status = HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, addr, word);
+        addr += 4;
+    }
+
+    HAL_FLASH_Lock();
+    return (status == HAL_OK) ? 1 : 0;
+}
+
+/**
+ * @brief  从存储区读取记录
+ * @param  region: 存储区编号
+ * @param  magic: 期望的记录类型魔数
+ * @param  data: 数据输出指针
+ * @param  len: 期望的数据长度(字节)
+ * @retval 1: 成功, 0: 无有效记录(未保存、格式变化或数据损坏)
+ */
+uint8_t Flash_LoadRecord(Flash_Region_t region, uint32_t magic, void *data, uint16_t len) {
+    if (region >= FLASH_REGION_NUM || data == NULL) return 0;
+
+    const Flash_RegionInfo_t *info = &flash_regions[region];
+    const Flash_RecordHeader_t *header = (const Flash_RecordHeader_t *)(uintptr_t)info->address;
+    const uint8_t *payload = (const uint8_t *)(uintptr_t)(info->address + sizeof(Flash_RecordHeader_t));
+
+    if (header->magic != magic || header->length != len) return 0;
+    if (header->checksum != Flash_Checksum(payload, len)) return 0;
+
+    memcpy(data, payload, len);
+    return 1;
+}
@@ -0,0 +1,27 @@
+/**
+ * @file flash_app.h
+ * @brief Flash参数存储模块头文件 - 片内Flash扇区保存标定/地图等掉电数据
+ */
+#ifndef FLASH_APP_H
+#define FLASH_APP_H
+
+#include "mydefine.h"
+
+// 存储区编号 (每个存储区独占一个Flash扇区，地址配置见mydefine.h)
+typedef enum {
+    FLASH_REGION_CALIB = 0,     // 传感器标定数据
+    FLASH_REGION_TRACK,         // 赛道学习地图
+    FLASH_REGION_NUM
+} Flash_Region_t;
+
+/**
+ * @brief 保存一条记录到存储区 (擦除整个扇区后写入，耗时约1s，期间CPU停顿)
+ */
+uint8_t Flash_SaveRecord(Flash_Region_t region, uint32_t magic, const void *data, uint16_t len);
+
+/**
+ * @brief 从存储区读取记录 (校验魔数、长度和校验和)
+ */
+uint8_t Flash_LoadRecord(Flash_Region_t region, uint32_t magic, void *data, uint16_t len);
+
+#endif
@@ -13,13 +13,67 @@ Gary_Data_t gary_data = {
     .normalize_data = {0},        // 8通道归一化数据初始值
     .line_state = LINE_LOST,      // 循线状态初始值
     .line_error = 0,              // 位置偏差初始值
+    .line_source = GARY_SOURCE_DIGITAL, // 偏差来源初始值
+    .line_contrast = 0,           // 对比度初始值
     .line_width = 0,              // 线宽初始值
     .data_ready = 0,              // 数据就绪标志
+    .sample_seq = 0,              // 采样序号
     .last_update_time = 0,        // 上次更新时间
+    .sample_us = 0,               // 采集时刻(us)
     .comm_error_count = 0,        // 通信错误计数
     .init_status = 0              // 初始化状态
 };
 
+// 灰度标定数据 (默认值，上电从Flash加载，可用gary cal重新标定)
+#define GARY_CAL_DEFAULT_ROW(v)  {v, v, v, v, v, v, v, v}
+static Gary_Calibration_t gary_cal = {
+    .white = GARY_CAL_DEFAULT_ROW(GARY_CAL_WHITE_DEFAULT),
+    .black = GARY_CAL_DEFAULT_ROW(GARY_CAL_BLACK_DEFAULT)
+};
+
+// 每通道归一化查找表：原始值 -> 亮度(黑=0，白=255)，标定变化时重建
+// 自适应阈值使能时按跟踪到的黑/白均值周期性重建，gary_lut_black/white记录当前表使用的端点
+static uint8_t gary_lut[8][256];
+static uint8_t gary_lut_black[8];
+static uint8_t gary_lut_white[8];
+static uint32_t gary_lut_follow_tick = 0;
+
+// 扫描标定状态：扫描期间记录每通道最小/最大原始值
+static uint8_t gary_cal_sweeping = 0;
+static uint8_t gary_sweep_min[8];
+static uint8_t gary_sweep_max[8];
+
+// 采样流水线：一次I2C DMA事务读取8通道原始模拟值，双缓冲
+// DMA写入gary_rx_buf[gary_rx_dma_idx]，完成后该缓冲区成为最新样本，下一次传输写入另一块
+static uint8_t gary_rx_buf[2][8];
+static uint8_t gary_rx_mode[2];                // 各缓冲区对应的采集模式 (Gary_AcqMode_t)
+static volatile uint8_t gary_rx_busy = 0;      // DMA传输进行中
+static volatile uint8_t gary_rx_error = 0;     // 传输错误标志 (错误回调置位)
+static volatile uint8_t gary_rx_ready = 0;     // 最新完成的缓冲区索引
+static volatile uint32_t gary_rx_seq = 0;      // 传输完成序号 (完成回调+1)
+static uint8_t gary_rx_dma_idx = 0;            // 当前DMA目标缓冲区索引
+static uint32_t gary_rx_start_tick = 0;        // 传输启动时间(ms)，用于超时检测
+static volatile uint32_t gary_rx_us[2];        // 各缓冲区采集时刻(us)：启动时记录，完成时修正为传输中点
+static uint32_t gary_sample_us = 0;            // 正在处理的样本采集时刻(us)
+static uint32_t gary_rx_handled_seq = 0;       // 已处理的传输序号
+
+// 自适应采集：位图简单时只读数字寄存器
+static Gary_Acq_t gary_acq = {
+    .adaptive = GARY_ACQ_ADAPTIVE
+};
+
+// 寻线标志：由丢线恢复状态机设置，丢线时循线状态报告为LINE_SEARCHING
+static uint8_t gary_searching = 0;
+
+static void Gary_BuildLUT(void);
+static void Gary_BuildChannelLUT(uint8_t ch, uint8_t black, uint8_t white);
+static void Gary_FollowThreshold(uint32_t now);
+static void Gary_ProcessSample(const uint8_t *raw);
+static void Gary_ProcessDigital(uint8_t digital);
+static void Gary_UpdateLine(uint8_t digital, uint8_t analog);
+static Gary_AcqMode_t Gary_SelectAcqMode(void);
+static void Gary_ResetBus(void);
+
 /**
  * @brief Gary传感器初始化函数
  */
@@ -34,15 +88,34 @@ void gary_init(void)
     gary_data.line_error = 0;
     gary_data.line_width = 0;
     gary_data.data_ready = 0;
+    gary_data.sample_seq = 0;
     gary_data.last_update_time = HAL_GetTick();
     gary_data.comm_error_count = 0;
     gary_data.init_status = 0;
 
+    // 等待进行中的DMA采样结束，之后的Ping/配置使用阻塞式访问
+    Gary_WaitBusIdle();
+    gary_rx_error = 0;
+    gary_rx_handled_seq = gary_rx_seq;
+
     // 清零模拟和归一化数据数组
     for(uint8_t i = 0; i < 8; i++) {
         gary_data.analog_data[i] = 0;
         gary_data.normalize_data[i] = 0;
     }
+    gary_data.line_source = GARY_SOURCE_DIGITAL;
+    gary_data.line_contrast = 0;
+
+    // 时域分类器从丢线状态开始，采集统计清零 (首帧读取模拟量)
+    Classifier_Init(&line_classifier);
+    Gary_ResetAcqStats();
+    gary_acq.calm = 0;
+    gary_acq.digital_run = 0;
+
+    // 加载Flash中的标定数据，无有效记录时使用默认值 (同时以标定值重置自适应阈值)
+    Threshold_Init(&gary_threshold, gary_cal.black, gary_cal.white);
+    Gary_LoadCalibration();
+    gary_cal_sweeping = 0;
 
     // 循环检测传感器连接，参考例程做法
     while(Ping() != 0 && retry_count < max_retries) {
@@ -55,7 +128,7 @@ void gary_init(void)
         // 初始化成功，配置传感器
         gary_data.init_status = 1;
 
-        // 关闭归一化模式，确保初始状态一致
+        // 关闭传感器端归一化模式，始终读取原始模拟值，归一化由查找表完成
         IIC_Anolog_Normalize(0x00);
         HAL_Delay(10);  // 等待传感器处理
     } else {
@@ -64,66 +137,67 @@ void gary_init(void)
 }
 
 /**
- * @brief Gary传感器任务函数
+ * @brief Gary传感器任务函数 (1ms周期)
+ * @note 非阻塞采样流水线：
+ *       1. 处理DMA已完成的新样本 (序号变化)
+ *       2. 检查传输错误/超时
+ *       3. 总线空闲时按自适应采集策略启动下一次DMA读取 (8字节模拟量或1字节数字位图)
+ *       模拟量事务在400kHz下约0.25ms，数字事务约0.09ms，CPU不等待总线
  */
 void gary_task(void)
 {
     static uint8_t retry_count = 0;
-    static uint8_t normalize_cycle = 0;  // 归一化周期计数
-    uint8_t result;
+    uint8_t failed = 0;
 
     // 检查初始化状态
     if (gary_data.init_status == 0) {
         return;  // 传感器未初始化，直接返回
     }
 
-    // 1. 读取数字模式数据
-    gary_data.digital_data = IIC_Get_Digtal();
-
-    // 2. 读取模拟模式数据
-    result = IIC_Get_Anolog(gary_data.analog_data, 8);
-
-    // 3. 检查读取结果
-    if (result == 1) {  // 读取成功
-        // 重置重试计数
+    // 1. 处理新样本 (DMA只会写入另一块缓冲区，此处读取无竞争)
+    uint32_t seq = gary_rx_seq;
+    if (seq != gary_rx_handled_seq) {
+        gary_rx_handled_seq = seq;
         retry_count = 0;
+        uint8_t ready = gary_rx_ready;
+        gary_sample_us = gary_rx_us[ready];
+        if (gary_rx_mode[ready] == GARY_ACQ_DIGITAL) {
+            Gary_ProcessDigital(gary_rx_buf[ready][0]);
+        } else {
+            Gary_ProcessSample(gary_rx_buf[ready]);
+        }
+    }
 
-        // 设置数据就绪标志
-        gary_data.data_ready = 1;
-
-        // 更新时间戳
-        gary_data.last_update_time = HAL_GetTick();
-
-        // 4. 每隔几个周期读取一次真正的归一化数据
-        normalize_cycle++;
-        if (normalize_cycle >= 3) {  // 每3个周期读取一次归一化数据
-            normalize_cycle = 0;
-
-            // 开启归一化模式，参考例程做法
-            if (IIC_Anolog_Normalize(0xFF)) {  // 开启所有通道归一化
-                HAL_Delay(10);  // 等待传感器处理，参考例程
-
-                // 读取归一化数据
-                if (IIC_Get_Anolog(gary_data.normalize_data, 8)) {
-                    // 归一化数据读取成功
-                }
+    // 2. 传输错误 (HAL已终止传输) 或超时 (总线挂死，复位I2C3)
+    if (gary_rx_error) {
+        gary_rx_error = 0;
+        failed = 1;
+    } else if (gary_rx_busy && (HAL_GetTick() - gary_rx_start_tick) > GARY_COMM_TIMEOUT) {
+        Gary_ResetBus();
+        failed = 1;
+    }
 
-                // 关闭归一化模式
-                IIC_Anolog_Normalize(0x00);
-            }
+    // 3. 启动下一次采样
+    if (!failed && !gary_rx_busy) {
+        uint8_t idx = gary_rx_ready ^ 1;
+        uint8_t ok;
+        gary_rx_dma_idx = idx;
+        gary_rx_mode[idx] = Gary_SelectAcqMode();
+        gary_rx_start_tick = HAL_GetTick();
+        gary_rx_us[idx] = Perf_GetMicros();
+        gary_rx_busy = 1;
+        if (gary_rx_mode[idx] == GARY_ACQ_DIGITAL) {
+            ok = IIC_Get_Digtal_DMA(gary_rx_buf[idx]);
         } else {
-            // 非归一化周期，使用简单映射
-            for(uint8_t i = 0; i < 8; i++) {
-                gary_data.normalize_data[i] = (gary_data.analog_data[i] * 100) / 255;
-            }
+            ok = IIC_Get_Anolog_DMA(gary_rx_buf[idx], 8);
         }
+        if (!ok) {
+            gary_rx_busy = 0;
+            failed = 1;
+        }
+    }
 
-        // 更新循线状态、偏差和线宽
-        gary_data.line_state = Gary_DetectLineState(gary_data.digital_data);
-        gary_data.line_error = Gary_CalculateLineError(gary_data.digital_data);
-        gary_data.line_width = Gary_GetLineWidth(gary_data.digital_data);
-
-    } else {  // 读取失败
+    if (failed) {
         // 处理通信失败和重试机制
         retry_count++;
 
@@ -141,8 +215,233 @@ void gary_task(void)
     }
 }
 
+/**
+ * @brief 处理一帧原始模拟数据
+ * @param raw 8通道原始模拟值
+ * @note 模拟量读取时数字位图在本地生成 (白=1，黑=0)：
+ *       自适应阈值使能且通道有效时原始值与跟踪阈值比较，否则查找表亮度与GARY_LINE_THRESHOLD比较
+ */
+static void Gary_ProcessSample(const uint8_t *raw)
+{
+    uint8_t digital = 0;
+    uint32_t now = HAL_GetTick();
+
+    // 1. 自适应阈值跟踪 (扫描标定期间暂停)，查找表归一化并生成数字位图
+    if (!gary_cal_sweeping) {
+        Threshold_Update(&gary_threshold, raw);
+        Gary_FollowThreshold(now);
+    }
+    for(uint8_t i = 0; i < 8; i++) {
+        uint8_t v = gary_lut[i][raw[i]];
+        uint8_t white;
+        gary_data.analog_data[i] = raw[i];
+        gary_data.normalize_data[i] = v;
+        if (gary_threshold.enabled && gary_threshold.valid[i]) {
+            white = (raw[i] >= gary_threshold.threshold[i]);
+        } else {
+            white = (v >= GARY_LINE_THRESHOLD);
+        }
+        if(white) {
+            digital |= (uint8_t)(1 << i);
+        }
+    }
+    gary_acq.analog_bitmap = digital;
+    gary_acq.analog_count++;
+
+    // 扫描标定期间记录每通道极值
+    if (gary_cal_sweeping) {
+        for(uint8_t i = 0; i < 8; i++) {
+            if (raw[i] < gary_sweep_min[i]) gary_sweep_min[i] = raw[i];
+            if (raw[i] > gary_sweep_max[i]) gary_sweep_max[i] = raw[i];
+        }
+    }
+
+    Gary_UpdateLine(digital, 1);
+}
+
+/**
+ * @brief 处理一帧传感器数字位图 (自适应采集的数字读取)
+ * @param digital 传感器数字寄存器 (白=1，黑=0)
+ * @note 位图与最近一次模拟量位图相同时线仍在同一探头区间内，保持上次模拟量质心偏差；
+ *       不同时按位图计算偏差，下一次采集由Gary_SelectAcqMode升级为模拟量
+ */
+static void Gary_ProcessDigital(uint8_t digital)
+{
+    gary_acq.digital_count++;
+    if (digital != gary_acq.analog_bitmap) {
+        gary_acq.mismatch_count++;
+        gary_acq.calm = 0;
+    }
+
+    Gary_UpdateLine(digital, 0);
+}
+
+/**
+ * @brief 由位图更新循线状态、偏差和线宽，并驱动时域分类器
+ * @param digital 数字位图 (白=1，黑=0)
+ * @param analog 1: 本帧为模拟量读取(normalize_data有效), 0: 数字读取
+ */
+static void Gary_UpdateLine(uint8_t digital, uint8_t analog)
+{
+    gary_data.digital_data = digital;
+
+    // 设置数据就绪标志，更新时间戳和采样序号
+    gary_data.data_ready = 1;
+    gary_data.last_update_time = HAL_GetTick();
+    gary_data.sample_us = gary_sample_us;
+    gary_data.sample_seq++;
+
+    // 1. 更新循线状态、偏差和线宽 (位图派生属性一次查表)
+    const Gary_Pattern_t *pat = Gary_GetPattern(digital);
+    gary_data.line_state = (Gary_LineState_t)pat->state;
+    if (gary_data.line_state == LINE_LOST && gary_searching) {
+        gary_data.line_state = LINE_SEARCHING;
+    }
+
+    // 优先使用模拟量质心(连续值)，对比度不足(丢线/全黑/未标定)时回退数字算法
+    float analog_error;
+    if (analog) {
+        if (Gary_CalculateAnalogLineError(gary_data.normalize_data, &analog_error, &gary_data.line_contrast)) {
+            gary_data.line_error = analog_error;
+            gary_data.line_source = GARY_SOURCE_ANALOG;
+        } else {
+            gary_data.line_error = pat->error;
+            gary_data.line_source = GARY_SOURCE_DIGITAL;
+        }
+    } else if (digital != gary_acq.analog_bitmap) {
+        gary_data.line_error = pat->error;
+        gary_data.line_source = GARY_SOURCE_DIGITAL;
+    }
+    gary_data.line_width = pat->width;
+
+    // 2. 多帧时域分类 (滞回+去抖)，输出稳定状态和路口事件
+    Classifier_Update(&line_classifier, gary_data.line_state, gary_data.line_error);
+}
+
+/**
+ * @brief 判断位图是否为简单位图 (单一连续黑线段，线宽不超过GARY_ACQ_MAX_WIDTH且位于中央通道)
+ */
+static uint8_t Gary_IsSimplePattern(uint8_t digital)
+{
+    const Gary_Pattern_t *pat = Gary_GetPattern(digital);
+    uint8_t line_bits = (uint8_t)~digital;
+
+    return pat->runs == 1 && pat->width <= GARY_ACQ_MAX_WIDTH
+        && (line_bits & (uint8_t)~GARY_ACQ_CENTER_MASK) == 0;
+}
+
+/**
+ * @brief 选择下一次采集模式
+ * @note 1. 位图非简单(边缘/多段/宽线/丢线)或分类器本帧与稳定状态不一致(过渡中)时读模拟量
+ *       2. 连续GARY_ACQ_CALM_FRAMES帧简单后才降级为数字读取
+ *       3. 连续数字读取GARY_ACQ_REFRESH次后强制读一次模拟量，刷新质心偏差和自适应阈值
+ */
+static Gary_AcqMode_t Gary_SelectAcqMode(void)
+{
+    uint8_t was_digital = (gary_acq.digital_run > 0);
+
+    if (!gary_acq.adaptive || gary_cal_sweeping || !gary_data.data_ready) {
+        gary_acq.calm = 0;
+        gary_acq.digital_run = 0;
+        return GARY_ACQ_ANALOG;
+    }
+
+    if (!Gary_IsSimplePattern(gary_data.digital_data) || line_classifier.frame != line_classifier.stable) {
+        gary_acq.calm = 0;
+    } else if (gary_acq.calm < GARY_ACQ_CALM_FRAMES) {
+        gary_acq.calm++;
+    }
+
+    if (gary_acq.calm < GARY_ACQ_CALM_FRAMES) {
+        if (was_digital) gary_acq.escalate_count++;
+        gary_acq.digital_run = 0;
+        return GARY_ACQ_ANALOG;
+    }
+
+    if (gary_acq.digital_run >= GARY_ACQ_REFRESH) {
+        gary_acq.forced_count++;
+        gary_acq.digital_run = 0;
+        return GARY_ACQ_ANALOG;
+    }
+
+    gary_acq.digital_run++;
+    return GARY_ACQ_DIGITAL;
+}
+
+/**
+ * @brief 复位I2C3 (DMA传输超时，总线挂死时调用)
+ */
+static void Gary_ResetBus(void)
+{
+    HAL_I2C_DeInit(&hi2c3);
+    MX_I2C3_Init();
+    gary_rx_busy = 0;
+}
+
+/**
+ * @brief 等待进行中的DMA采样结束 (阻塞式I2C访问前调用)
+ * @note 超过GARY_COMM_TIMEOUT仍未结束则复位I2C3
+ */
+void Gary_WaitBusIdle(void)
+{
+    uint32_t start = HAL_GetTick();
+
+    while (gary_rx_busy) {
+        if ((HAL_GetTick() - start) > GARY_COMM_TIMEOUT) {
+            Gary_ResetBus();
+            break;
+        }
+    }
+}
+
+/**
+ * @brief I2C存储器读完成回调 (DMA传输完成)
+ */
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+    if (hi2c->Instance == I2C3) {
+        uint32_t start_us = gary_rx_us[gary_rx_dma_idx];
+        gary_rx_us[gary_rx_dma_idx] = start_us + (Perf_GetMicros() - start_us) / 2;
+        gary_rx_ready = gary_rx_dma_idx;
+        gary_rx_seq++;
+        gary_rx_busy = 0;
+    }
+}
+
+/**
+ * @brief I2C错误回调 (NACK/仲裁丢失/总线错误，HAL已终止DMA)
+ */
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+    if (hi2c->Instance == I2C3) {
+        gary_rx_error = 1;
+        gary_rx_busy = 0;
+    }
+}
+
 // ==================== 状态检查函数 ====================
 
+/**
+ * @brief 检查是否检测到线
+ * @retval 1: 数字位图有线或模拟量质心有效, 0: 丢线或数据未就绪
+ */
+uint8_t Gary_IsLineFound(void)
+{
+    if (!gary_data.data_ready) return 0;
+
+    // 细线落在两探头之间时位图全白，但模拟量质心仍然有效
+    return (gary_data.line_state != LINE_LOST && gary_data.line_state != LINE_SEARCHING)
+           || gary_data.line_source == GARY_SOURCE_ANALOG;
+}
+
+/**
+ * @brief 设置寻线标志
+ */
+void Gary_SetSearching(uint8_t searching)
+{
+    gary_searching = searching;
+}
+
 /**
  * @brief 检查Gary数据是否就绪
  */
@@ -221,160 +520,266 @@ float Gary_GetLineError(void)
 // ==================== 循线检测算法 ====================
 
 /**
- * @brief 检测循线状态 (优化版本)
- * @note 基于新权重数组{-4,-3,-2,-1,1,2,3,4}重新优化阈值设置
- *       - 扩大中央状态范围：±10 → ±30
- *       - 调整中间状态阈值：30/60 → 60/85
- *       - 权重范围缩小43%，配合更宽松的阈值设置
- *       - 解决实际使用中只出现三种状态的问题
+ * @brief 计算位置偏差 (标定模拟量质心算法)
+ * @param normalized 8通道查找表归一化亮度 (黑=0，白=255)
+ * @param error 输出位置偏差 (-4.0到+4.0，与数字算法刻度一致)
+ * @param contrast 输出对比度 (归一化黑度最大值-最小值)
+ * @retval 1: 结果有效, 0: 对比度不足，应回退数字算法
+ * @note 1. 黑度 d = (255-亮度)/255
+ *       2. 以黑度峰值通道为中心取窗口，减去背景黑度后求质心(通道序号空间)
+ *       3. 质心序号在相邻通道权重之间线性插值，得到连续偏差
  */
-Gary_LineState_t Gary_DetectLineState(uint8_t digital_data)
+uint8_t Gary_CalculateAnalogLineError(const uint8_t *normalized, float *error, float *contrast)
 {
-    // 基于8位数字数据进行状态检测
-    // 注意：白场高电平(1)，黑场低电平(0)
-    // 所以黑线会产生0，白场会产生1
+    static const float weights[8] = GARY_LINE_WEIGHTS;
+    float dark[8];
+    float dark_min = 1.0f;
+    float dark_max = 0.0f;
+    uint8_t peak = 0;
 
-    uint8_t line_bits = ~digital_data;  // 取反，让黑线变成1，白场变成0
+    // 1. 黑度，同时找出最小值与峰值通道
+    for(uint8_t i = 0; i < 8; i++) {
+        float d = (float)(255 - normalized[i]) * (1.0f / 255.0f);
+        dark[i] = d;
 
-    // 快速检测特殊情况
-    if(line_bits == 0x00) {
-        return LINE_LOST;  // 没有检测到线
+        if(d < dark_min) dark_min = d;
+        if(d > dark_max) {
+            dark_max = d;
+            peak = i;
+        }
     }
 
-    // 使用位运算快速计算线的数量
-    uint8_t line_count = 0;
-    uint8_t temp = line_bits;
-    while(temp) {
-        line_count++;
-        temp &= (temp - 1);  // 清除最低位的1
+    *contrast = dark_max - dark_min;
+    if(*contrast < GARY_CONTRAST_MIN) {
+        return 0;  // 全白(丢线)、全黑(路口)或标定失效
     }
 
-    // 检测交叉路口或宽线
-    if(line_count >= 6) {
-        return LINE_INTERSECTION;
+    // 2. 峰值窗口质心，减去背景黑度抑制环境光偏置
+    uint8_t lo = (peak >= GARY_CENTROID_WINDOW) ? peak - GARY_CENTROID_WINDOW : 0;
+    uint8_t hi = (peak + GARY_CENTROID_WINDOW <= 7) ? peak + GARY_CENTROID_WINDOW : 7;
+    float mass = 0.0f;
+    float moment = 0.0f;
+    for(uint8_t i = lo; i <= hi; i++) {
+        float m = dark[i] - dark_min;
+        mass += m;
+        moment += m * (float)i;
     }
+    float pos = moment / mass;  // 峰值通道质量即为contrast，mass必大于0
 
-    // 检测T型路口
-    if((line_bits & 0xF0) == 0xF0) {  // 左侧4位全为1
-        return LINE_T_LEFT;
-    }
-    if((line_bits & 0x0F) == 0x0F) {  // 右侧4位全为1
-        return LINE_T_RIGHT;
-    }
+    // 3. 通道序号 -> 权重刻度 (相邻通道间线性插值)
+    uint8_t k = (uint8_t)pos;
+    if(k > 6) k = 6;
+    float e = weights[k] + (weights[k + 1] - weights[k]) * (pos - (float)k);
+
+    // 范围限制
+    if(e > GARY_ERROR_MAX) e = GARY_ERROR_MAX;
+    if(e < GARY_ERROR_MIN) e = GARY_ERROR_MIN;
+
+    *error = e;
+    return 1;
+}
 
-    // 直接调用偏差计算函数进行状态判定
-    float center = Gary_CalculateLineError(digital_data);
+// ==================== 灰度标定 ====================
 
-    // 使用优化的阈值判断 (基于平均值算法调整)
-    // 中央状态判定
-    if(center >= -GARY_CENTER_THRESHOLD && center <= GARY_CENTER_THRESHOLD) {
-        return LINE_CENTER;                    // [-0.5, +0.5]
+/**
+ * @brief 按给定黑/白端点重建单通道归一化查找表
+ * @note 亮度 = (原始-黑)/(白-黑)×255，限幅到[0,255]
+ *       黑白差过小的通道恒输出255(白)，不参与定位
+ */
+static void Gary_BuildChannelLUT(uint8_t ch, uint8_t black, uint8_t white)
+{
+    int32_t span = (int32_t)white - black;
+
+    gary_lut_black[ch] = black;
+    gary_lut_white[ch] = white;
+
+    if(span < GARY_CAL_MIN_SPAN && span > -GARY_CAL_MIN_SPAN) {
+        memset(gary_lut[ch], 255, 256);
+        return;
     }
 
-    // 右偏状态判定 (从小到大)
-    if(center > GARY_CENTER_THRESHOLD) {
-        if(center <= GARY_SLIGHT_THRESHOLD) {
-            return LINE_SLIGHT_RIGHT;          // (0.5, 1.5]
-        }
-        else if(center <= GARY_MODERATE_THRESHOLD) {
-            return LINE_MODERATE_RIGHT;        // (1.5, 2.5]
-        }
-        else {
-            return LINE_SHARP_RIGHT;           // (2.5, +4.0]
-        }
+    for(int32_t raw = 0; raw < 256; raw++) {
+        int32_t v = ((raw - black) * 255 + span / 2) / span;
+        if(v < 0) v = 0;
+        if(v > 255) v = 255;
+        gary_lut[ch][raw] = (uint8_t)v;
     }
+}
 
-    // 左偏状态判定 (从小到大，绝对值)
-    if(center < -GARY_CENTER_THRESHOLD) {
-        if(center >= -GARY_SLIGHT_THRESHOLD) {
-            return LINE_SLIGHT_LEFT;           // [-1.5, -0.5)
-        }
-        else if(center >= -GARY_MODERATE_THRESHOLD) {
-            return LINE_MODERATE_LEFT;         // [-2.5, -1.5)
-        }
-        else {
-            return LINE_SHARP_LEFT;            // [-4.0, -2.5)
+/**
+ * @brief 根据标定值重建各通道归一化查找表，并以标定值重置自适应阈值
+ */
+static void Gary_BuildLUT(void)
+{
+    for(uint8_t i = 0; i < 8; i++) {
+        Gary_BuildChannelLUT(i, gary_cal.black[i], gary_cal.white[i]);
+    }
+    Threshold_Reset(&gary_threshold, gary_cal.black, gary_cal.white);
+}
+
+/**
+ * @brief 查找表跟随自适应阈值
+ * @note 每GARY_ADAPT_LUT_PERIOD_MS检查一次，端点变化达到GARY_ADAPT_LUT_STEP的有效通道才重建，
+ *       使模拟量质心的归一化亮度与数字化阈值保持一致 (单通道重建约256次除法)
+ */
+static void Gary_FollowThreshold(uint32_t now)
+{
+    if (!gary_threshold.enabled || now - gary_lut_follow_tick < GARY_ADAPT_LUT_PERIOD_MS) return;
+    gary_lut_follow_tick = now;
+
+    for(uint8_t i = 0; i < 8; i++) {
+        if (!gary_threshold.valid[i]) continue;
+
+        uint8_t black = (uint8_t)(gary_threshold.black[i] + 0.5f);
+        uint8_t white = (uint8_t)(gary_threshold.white[i] + 0.5f);
+        int16_t db = (int16_t)black - gary_lut_black[i];
+        int16_t dw = (int16_t)white - gary_lut_white[i];
+
+        if (db >= GARY_ADAPT_LUT_STEP || db <= -GARY_ADAPT_LUT_STEP
+            || dw >= GARY_ADAPT_LUT_STEP || dw <= -GARY_ADAPT_LUT_STEP) {
+            Gary_BuildChannelLUT(i, black, white);
+            gary_threshold.lut_rebuilds++;
         }
     }
+}
 
-    return LINE_LOST;
+/**
+ * @brief 自适应采集使能/禁用
+ * @param enable 1: 位图简单时只读数字寄存器, 0: 始终读取模拟量
+ */
+void Gary_SetAdaptiveAcq(uint8_t enable)
+{
+    gary_acq.adaptive = enable ? 1 : 0;
+    gary_acq.calm = 0;
 }
 
 /**
- * @brief 计算位置偏差 (平均值算法)
- * @note 基于平均值算法，输出范围[-4.0, +4.0]
- *       - 使用加权平均而非归一化计算
- *       - 解决单传感器±100极值问题
- *       - 实现更平滑的状态过渡
+ * @brief 获取自适应采集统计
  */
-float Gary_CalculateLineError(uint8_t digital_data)
+const Gary_Acq_t* Gary_GetAcqStats(void)
 {
-    uint8_t line_bits = ~digital_data;  // 取反，让黑线变成1
+    return &gary_acq;
+}
 
-    // 快速检测无线情况
-    if(line_bits == 0x00) {
-        return 0.0f;  // 没有检测到线，返回0偏差
-    }
+/**
+ * @brief 清除自适应采集统计
+ */
+void Gary_ResetAcqStats(void)
+{
+    gary_acq.analog_count = 0;
+    gary_acq.digital_count = 0;
+    gary_acq.forced_count = 0;
+    gary_acq.escalate_count = 0;
+    gary_acq.mismatch_count = 0;
+    gary_acq.start_tick = HAL_GetTick();
+}
 
-    // 使用预计算权重数组
-    static const float weights[8] = GARY_LINE_WEIGHTS;  // {-4.0,-3.0,-2.0,-1.0,1.0,2.0,3.0,4.0}
-    float weighted_sum = 0.0f;
-    uint8_t black_line_count = 0;
+/**
+ * @brief 自适应阈值使能/禁用
+ * @param enable 1: 跟踪环境光, 0: 恢复标定查找表
+ * @note 禁用或重新使能时均以标定值重建查找表并重置跟踪
+ */
+void Gary_SetAdaptiveThreshold(uint8_t enable)
+{
+    gary_threshold.enabled = enable ? 1 : 0;
+    Gary_BuildLUT();
+}
 
-    // 平均值计算循环
+/**
+ * @brief 开始扫描标定 (之后将小车传感器在黑线和白色区域间来回扫过)
+ */
+void Gary_CalibrationStart(void)
+{
     for(uint8_t i = 0; i < 8; i++) {
-        if(line_bits & (1 << i)) {
-            weighted_sum += weights[i];
-            black_line_count++;
-        }
+        gary_sweep_min[i] = 255;
+        gary_sweep_max[i] = 0;
     }
+    gary_cal_sweeping = 1;
+}
 
-    if(black_line_count > 0) {
-        float error = weighted_sum / (float)black_line_count;
+/**
+ * @brief 结束扫描标定，以各通道最小值为黑场、最大值为白场
+ * @retval 黑白差满足GARY_CAL_MIN_SPAN的通道数 (0表示未扫到有效数据，标定未更新)
+ */
+uint8_t Gary_CalibrationStop(void)
+{
+    uint8_t valid = 0;
 
-        // 范围限制
-        if(error > GARY_ERROR_MAX) error = GARY_ERROR_MAX;
-        if(error < GARY_ERROR_MIN) error = GARY_ERROR_MIN;
+    if(!gary_cal_sweeping) return 0;
+    gary_cal_sweeping = 0;
 
-        return error;
+    for(uint8_t i = 0; i < 8; i++) {
+        if(gary_sweep_max[i] >= gary_sweep_min[i] + GARY_CAL_MIN_SPAN) valid++;
     }
+    if(valid == 0) return 0;
 
-    return 0.0f;  // 异常情况，返回0偏差
+    for(uint8_t i = 0; i < 8; i++) {
+        gary_cal.black[i] = gary_sweep_min[i];
+        gary_cal.white[i] = gary_sweep_max[i];
+    }
+    Gary_BuildLUT();
+    return valid;
 }
 
 /**
- * @brief 检测线宽信息
+ * @brief 检查是否正在扫描标定
  */
-uint8_t Gary_GetLineWidth(uint8_t digital_data)
+uint8_t Gary_IsCalibrating(void)
 {
-    uint8_t line_bits = ~digital_data;  // 取反，让黑线变成1
-    uint8_t line_width = 0;
+    return gary_cal_sweeping;
+}
 
-    // 计算连续的黑线位数
-    for(uint8_t i = 0; i < 8; i++) {
-        if(line_bits & (1 << i)) {
-            line_width++;
-        }
-    }
+/**
+ * @brief 保存标定数据到Flash (擦写期间CPU停顿约1s，电机运行时不要调用)
+ * @retval 1: 成功, 0: 失败
+ */
+uint8_t Gary_SaveCalibration(void)
+{
+    return Flash_SaveRecord(FLASH_REGION_CALIB, GARY_CAL_MAGIC, &gary_cal, sizeof(gary_cal));
+}
+
+/**
+ * @brief 从Flash加载标定数据并重建查找表
+ * @retval 1: 已加载Flash数据, 0: 无有效记录，使用默认值
+ */
+uint8_t Gary_LoadCalibration(void)
+{
+    Gary_Calibration_t cal;
+    uint8_t loaded = Flash_LoadRecord(FLASH_REGION_CALIB, GARY_CAL_MAGIC, &cal, sizeof(cal));
 
-    return line_width;
+    if(loaded) {
+        gary_cal = cal;
+    }
+    Gary_BuildLUT();
+    return loaded;
 }
 
 /**
- * @brief 检测交叉路口
+ * @brief 以当前模拟数据标定白场 (传感器全部置于白色区域时调用)
  */
-uint8_t Gary_DetectIntersection(uint8_t digital_data)
+void Gary_CalibrateWhite(void)
 {
-    uint8_t line_bits = ~digital_data;  // 取反，让黑线变成1
-    uint8_t line_count = 0;
+    for(uint8_t i = 0; i < 8; i++) {
+        gary_cal.white[i] = gary_data.analog_data[i];
+    }
+    Gary_BuildLUT();
+}
 
-    // 计算检测到的线的数量
+/**
+ * @brief 以当前模拟数据标定黑场 (传感器全部置于黑线上时调用)
+ */
+void Gary_CalibrateBlack(void)
+{
     for(uint8_t i = 0; i < 8; i++) {
-        if(line_bits & (1 << i)) {
-            line_count++;
-        }
+        gary_cal.black[i] = gary_data.analog_data[i];
     }
+    Gary_BuildLUT();
+}
 
-    // 如果检测到6个或以上传感器有线，认为是交叉路口
-    return (line_count >= 6) ? 1 : 0;
-}
\ No newline at end of file
+/**
+ * @brief 获取标定数据
+ */
+const Gary_Calibration_t* Gary_GetCalibration(void)
+{
+    return &gary_cal;
+}
@@ -19,16 +19,62 @@ typedef enum {
     LINE_SEARCHING          // 寻线状态
 } Gary_LineState_t;
 
+// 位置偏差来源
+typedef enum {
+    GARY_SOURCE_DIGITAL = 0,         // 数字位图平均值 (对比度不足时回退)
+    GARY_SOURCE_ANALOG               // 标定后的模拟量质心
+} Gary_LineSource_t;
+
+// 采集模式 (每次I2C事务读取的内容)
+typedef enum {
+    GARY_ACQ_ANALOG = 0,             // 8字节原始模拟值，本地生成位图并计算质心
+    GARY_ACQ_DIGITAL                 // 1字节传感器数字位图
+} Gary_AcqMode_t;
+
+// 自适应采集状态与统计
+typedef struct {
+    uint8_t adaptive;                // 使能标志 (0: 始终读取模拟量)
+    uint8_t calm;                    // 连续简单模拟帧数
+    uint8_t digital_run;             // 连续数字读取次数
+    uint8_t analog_bitmap;           // 最近一次模拟量读取生成的位图
+    uint32_t analog_count;           // 模拟量读取次数 (含强制刷新)
+    uint32_t digital_count;          // 数字读取次数
+    uint32_t forced_count;           // 强制刷新模拟量次数
+    uint32_t escalate_count;         // 数字读取后因边缘/歧义/过渡升级为模拟量的次数
+    uint32_t mismatch_count;         // 数字位图与最近模拟量位图不一致次数
+    uint32_t start_tick;             // 统计开始时间(ms)
+} Gary_Acq_t;
+
+// 8位数字位图派生属性 (编译期生成的256项模式表，以数字位图直接索引)
+typedef struct {
+    float error;                     // 位置偏差 (平均值算法，-4.0到+4.0)
+    float center;                    // 黑线质心通道序号 (0.0-7.0，无线时为3.5)
+    uint8_t width;                   // 黑线探头数
+    uint8_t runs;                    // 连续黑线段数 (>1表示分叉/多条线)
+    uint8_t state;                   // 单帧循线状态 (Gary_LineState_t)
+    uint8_t intersection;            // 交叉路口标志 (黑线探头数≥6)
+} Gary_Pattern_t;
+
+// 灰度标定数据 (每通道白场/黑场原始模拟值)
+typedef struct {
+    uint8_t white[8];                // 白场原始值
+    uint8_t black[8];                // 黑场原始值
+} Gary_Calibration_t;
+
 // Gary传感器数据结构
 typedef struct {
     uint8_t digital_data;            // 8通道数字数据 (位图)
     uint8_t analog_data[8];          // 8通道模拟数据 (0-255)
-    uint8_t normalize_data[8];       // 8通道归一化数据
+    uint8_t normalize_data[8];       // 8通道归一化亮度 (查找表输出，黑=0，白=255)
     Gary_LineState_t line_state;     // 当前循线状态
     float line_error;                // 位置偏差值 (-4.0到+4.0)
+    uint8_t line_source;             // 位置偏差来源 (Gary_LineSource_t)
+    float line_contrast;             // 模拟量对比度 (0.0-1.0)
     uint8_t line_width;              // 检测到的线宽
     uint8_t data_ready;              // 数据就绪标志
+    uint32_t sample_seq;             // 采样序号 (每处理一帧新数据+1，用于判断是否为新样本)
     uint32_t last_update_time;       // 上次更新时间(ms)
+    uint32_t sample_us;              // 本帧采集时刻(us，Perf_GetMicros)：I2C DMA传输中点
     uint8_t comm_error_count;        // 通信错误计数
     uint8_t init_status;             // 初始化状态标志
 } Gary_Data_t;
@@ -45,6 +91,21 @@ void gary_init(void);
  */
 void gary_task(void);
 
+/**
+ * @brief 等待进行中的DMA采样结束 (阻塞式I2C访问前调用)
+ */
+void Gary_WaitBusIdle(void);
+
+/**
+ * @brief 检查是否检测到线 (数字位图有线或模拟量质心有效)
+ */
+uint8_t Gary_IsLineFound(void);
+
+/**
+ * @brief 设置寻线标志 (丢线恢复期间循线状态显示为LINE_SEARCHING)
+ */
+void Gary_SetSearching(uint8_t searching);
+
 /**
  * @brief 检查Gary数据是否就绪
  */
@@ -95,6 +156,52 @@ Gary_LineState_t Gary_DetectLineState(uint8_t digital_data);
  */
 float Gary_CalculateLineError(uint8_t digital_data);
 
+/**
+ * @brief 获取数字位图的派生属性 (查表)
+ */
+const Gary_Pattern_t* Gary_GetPattern(uint8_t digital_data);
+
+/**
+ * @brief 计算位置偏差 (标定模拟量质心算法，连续值)
+ */
+uint8_t Gary_CalculateAnalogLineError(const uint8_t *normalized, float *error, float *contrast);
+
+/**
+ * @brief 以当前模拟数据标定白场/黑场
+ */
+void Gary_CalibrateWhite(void);
+void Gary_CalibrateBlack(void);
+
+/**
+ * @brief 获取标定数据
+ */
+const Gary_Calibration_t* Gary_GetCalibration(void);
+
+/**
+ * @brief 自适应阈值使能/禁用 (以标定值重建查找表并重置跟踪)
+ */
+void Gary_SetAdaptiveThreshold(uint8_t enable);
+
+/**
+ * @brief 自适应采集使能/禁用、统计读取与清除
+ */
+void Gary_SetAdaptiveAcq(uint8_t enable);
+const Gary_Acq_t* Gary_GetAcqStats(void);
+void Gary_ResetAcqStats(void);
+
+/**
+ * @brief 扫描标定 - 开始/结束记录每通道极值
+ */
+void Gary_CalibrationStart(void);
+uint8_t Gary_CalibrationStop(void);
+uint8_t Gary_IsCalibrating(void);
+
+/**
+ * @brief 标定数据Flash保存/加载
+ */
+uint8_t Gary_SaveCalibration(void);
+uint8_t Gary_LoadCalibration(void);
+
 /**
  * @brief 检测线宽信息
  */
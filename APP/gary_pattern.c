@@ -0,0 +1,89 @@
+/**
+ * @file gary_pattern.c
+ * @brief Gary循线模式表 - 8位数字位图的派生属性(状态/偏差/质心/线宽/线段数)编译期展开为256项查找表
+ * @note 不访问硬件，主机端测试工程(tests/)直接编译本文件，API声明见gary_app.h
+ */
+#include "gary_app.h"
+
+// 由GARY_WEIGHT_0..7和状态阈值宏在编译期展开，p为数字位图(白=1，黑线=0)
+// 主机端测试tests/test_gary_pattern.c把256项逐一与逐位循环的参考算法比对
+#define GP_BIT(p, i)        ((((p) >> (i)) & 1) ? 0 : 1)       // 第i路是否检测到黑线
+#define GP_WIDTH(p)         (GP_BIT(p,0) + GP_BIT(p,1) + GP_BIT(p,2) + GP_BIT(p,3) + \
+                             GP_BIT(p,4) + GP_BIT(p,5) + GP_BIT(p,6) + GP_BIT(p,7))
+#define GP_WSUM(p)          (GP_BIT(p,0) * GARY_WEIGHT_0 + GP_BIT(p,1) * GARY_WEIGHT_1 + \
+                             GP_BIT(p,2) * GARY_WEIGHT_2 + GP_BIT(p,3) * GARY_WEIGHT_3 + \
+                             GP_BIT(p,4) * GARY_WEIGHT_4 + GP_BIT(p,5) * GARY_WEIGHT_5 + \
+                             GP_BIT(p,6) * GARY_WEIGHT_6 + GP_BIT(p,7) * GARY_WEIGHT_7)
+#define GP_ISUM(p)          (GP_BIT(p,1) * 1 + GP_BIT(p,2) * 2 + GP_BIT(p,3) * 3 + GP_BIT(p,4) * 4 + \
+                             GP_BIT(p,5) * 5 + GP_BIT(p,6) * 6 + GP_BIT(p,7) * 7)
+#define GP_RISE(p, i)       (GP_BIT(p,i) * (1 - GP_BIT(p,(i) - 1)))  // 第i路为黑线段起点
+#define GP_RUNS(p)          (GP_BIT(p,0) + GP_RISE(p,1) + GP_RISE(p,2) + GP_RISE(p,3) + \
+                             GP_RISE(p,4) + GP_RISE(p,5) + GP_RISE(p,6) + GP_RISE(p,7))
+#define GP_CLAMP(e)         ((e) > GARY_ERROR_MAX ? GARY_ERROR_MAX : ((e) < GARY_ERROR_MIN ? GARY_ERROR_MIN : (e)))
+#define GP_ERROR(p)         (GP_WIDTH(p) ? GP_CLAMP(GP_WSUM(p) / (float)GP_WIDTH(p)) : 0.0f)
+#define GP_CENTER(p)        (GP_WIDTH(p) ? (float)GP_ISUM(p) / (float)GP_WIDTH(p) : 3.5f)
+#define GP_LB(p)            ((~(p)) & 0xFF)                      // 黑线位图
+#define GP_OFFSET_STATE(e) \
+    ((e) >= -GARY_CENTER_THRESHOLD && (e) <= GARY_CENTER_THRESHOLD ? LINE_CENTER : \
+     (e) > GARY_CENTER_THRESHOLD ? ((e) <= GARY_SLIGHT_THRESHOLD ? LINE_SLIGHT_RIGHT : \
+                                    (e) <= GARY_MODERATE_THRESHOLD ? LINE_MODERATE_RIGHT : LINE_SHARP_RIGHT) : \
+     ((e) >= -GARY_SLIGHT_THRESHOLD ? LINE_SLIGHT_LEFT : \
+      (e) >= -GARY_MODERATE_THRESHOLD ? LINE_MODERATE_LEFT : LINE_SHARP_LEFT))
+#define GP_STATE(p) \
+    (GP_LB(p) == 0 ? LINE_LOST : \
+     GP_WIDTH(p) >= 6 ? LINE_INTERSECTION : \
+     (GP_LB(p) & 0xF0) == 0xF0 ? LINE_T_LEFT : \
+     (GP_LB(p) & 0x0F) == 0x0F ? LINE_T_RIGHT : \
+     GP_OFFSET_STATE(GP_ERROR(p)))
+#define GP_ENTRY(p)         {GP_ERROR(p), GP_CENTER(p), GP_WIDTH(p), GP_RUNS(p), GP_STATE(p), GP_WIDTH(p) >= 6}
+#define GP_ROW4(p)          GP_ENTRY(p), GP_ENTRY((p) + 1), GP_ENTRY((p) + 2), GP_ENTRY((p) + 3)
+#define GP_ROW16(p)         GP_ROW4(p), GP_ROW4((p) + 4), GP_ROW4((p) + 8), GP_ROW4((p) + 12)
+#define GP_ROW64(p)         GP_ROW16(p), GP_ROW16((p) + 16), GP_ROW16((p) + 32), GP_ROW16((p) + 48)
+
+static const Gary_Pattern_t gary_pattern_lut[256] = {
+    GP_ROW64(0), GP_ROW64(64), GP_ROW64(128), GP_ROW64(192)
+};
+
+// ==================== 循线检测算法 (查表) ====================
+
+/**
+ * @brief 获取数字位图的派生属性
+ * @param digital_data 8位数字位图 (白=1，黑线=0)
+ * @retval 模式表项指针 (偏差/质心/线宽/线段数/状态一次取得)
+ */
+const Gary_Pattern_t* Gary_GetPattern(uint8_t digital_data)
+{
+    return &gary_pattern_lut[digital_data];
+}
+
+/**
+ * @brief 检测循线状态 (查表)
+ */
+Gary_LineState_t Gary_DetectLineState(uint8_t digital_data)
+{
+    return (Gary_LineState_t)gary_pattern_lut[digital_data].state;
+}
+
+/**
+ * @brief 计算位置偏差 (查表，平均值算法)
+ */
+float Gary_CalculateLineError(uint8_t digital_data)
+{
+    return gary_pattern_lut[digital_data].error;
+}
+
+/**
+ * @brief 检测线宽信息 (查表)
+ */
+uint8_t Gary_GetLineWidth(uint8_t digital_data)
+{
+    return gary_pattern_lut[digital_data].width;
+}
+
+/**
+ * @brief 检测交叉路口 (查表)
+ */
+uint8_t Gary_DetectIntersection(uint8_t digital_data)
+{
+    return gary_pattern_lut[digital_data].intersection;
+}
@@ -0,0 +1,93 @@
+/**
+ * @file gary_threshold.c
+ * @brief 灰度自适应阈值模块实现 - 按通道在线跟踪黑/白两类原始值均值，给出数字化阈值
+ * @note 在线两均值(硬分配EM)：每帧按当前阈值把原始值归入黑类或白类，只更新所属类均值
+ *       (指数平均，速率GARY_ADAPT_RATE)，阈值取两类均值中点。
+ *       1. 均值相对标定值的漂移限制在±GARY_ADAPT_MAX_DRIFT，单通道长时间只看到一类时不会跑飞
+ *       2. 两类均值差小于GARY_CAL_MIN_SPAN时通道无效，阈值保持不变
+ *       场地光照变化时白场/黑场整体平移，阈值随之平移，无需重新标定。
+ */
+#include "gary_threshold.h"
+
+Gary_Threshold_t gary_threshold;
+
+/**
+ * @brief 自适应阈值初始化函数
+ * @param th 自适应阈值指针
+ * @param black 8通道参考黑场原始值
+ * @param white 8通道参考白场原始值
+ */
+void Threshold_Init(Gary_Threshold_t* th, const uint8_t* black, const uint8_t* white) {
+    if (th == NULL) return;
+
+    memset(th, 0, sizeof(*th));
+    th->enabled = GARY_ADAPT_ENABLE;
+    Threshold_Reset(th, black, white);
+}
+
+/**
+ * @brief 以标定值重置两类均值和漂移基准
+ * @param th 自适应阈值指针
+ * @param black 8通道参考黑场原始值
+ * @param white 8通道参考白场原始值
+ * @note 标定变化(扫描/单点标定/Flash加载)时调用，统计计数同时清零
+ */
+void Threshold_Reset(Gary_Threshold_t* th, const uint8_t* black, const uint8_t* white) {
+    if (th == NULL || black == NULL || white == NULL) return;
+
+    for (uint8_t i = 0; i < 8; i++) {
+        th->ref_black[i] = black[i];
+        th->ref_white[i] = white[i];
+        th->black[i] = (float)black[i];
+        th->white[i] = (float)white[i];
+        th->threshold[i] = (uint8_t)(((uint16_t)black[i] + white[i] + 1) / 2);
+        th->valid[i] = (white[i] >= black[i] + GARY_CAL_MIN_SPAN);
+        th->black_count[i] = 0;
+        th->white_count[i] = 0;
+    }
+    th->clamp_count = 0;
+}
+
+/**
+ * @brief 均值限制在参考值±GARY_ADAPT_MAX_DRIFT且不超出原始值范围
+ */
+static float Threshold_Bound(Gary_Threshold_t* th, float mean, uint8_t ref) {
+    float lo = (float)ref - GARY_ADAPT_MAX_DRIFT;
+    float hi = (float)ref + GARY_ADAPT_MAX_DRIFT;
+
+    if (lo < 0.0f) lo = 0.0f;
+    if (hi > 255.0f) hi = 255.0f;
+    if (mean < lo) { th->clamp_count++; return lo; }
+    if (mean > hi) { th->clamp_count++; return hi; }
+    return mean;
+}
+
+/**
+ * @brief 逐帧更新两类均值和阈值
+ * @param th 自适应阈值指针
+ * @param raw 8通道原始模拟值
+ */
+void Threshold_Update(Gary_Threshold_t* th, const uint8_t* raw) {
+    if (th == NULL || !th->enabled) return;
+
+    for (uint8_t i = 0; i < 8; i++) {
+        float x = (float)raw[i];
+
+        // 1. 按当前阈值归类，只更新所属类均值
+        if (raw[i] < th->threshold[i]) {
+            th->black[i] += GARY_ADAPT_RATE * (x - th->black[i]);
+            th->black[i] = Threshold_Bound(th, th->black[i], th->ref_black[i]);
+            th->black_count[i]++;
+        } else {
+            th->white[i] += GARY_ADAPT_RATE * (x - th->white[i]);
+            th->white[i] = Threshold_Bound(th, th->white[i], th->ref_white[i]);
+            th->white_count[i]++;
+        }
+
+        // 2. 两类可分时阈值取中点，否则保持
+        th->valid[i] = (th->white[i] - th->black[i] >= (float)GARY_CAL_MIN_SPAN);
+        if (th->valid[i]) {
+            th->threshold[i] = (uint8_t)(0.5f * (th->black[i] + th->white[i]) + 0.5f);
+        }
+    }
+}
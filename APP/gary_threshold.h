@@ -0,0 +1,45 @@
+/**
+ * @file gary_threshold.h
+ * @brief 灰度自适应阈值模块头文件 - 按通道在线跟踪黑/白两类原始值均值，给出数字化阈值
+ */
+#ifndef GARY_THRESHOLD_H
+#define GARY_THRESHOLD_H
+
+#include "mydefine.h"
+
+// 自适应阈值配置参数已迁移到mydefine.h统一管理
+
+// 自适应阈值数据结构 (原始值域，8通道)
+typedef struct {
+    uint8_t enabled;                   // 使能标志 (0: 使用标定查找表+GARY_LINE_THRESHOLD)
+    float black[8];                    // 黑类均值(原始值)
+    float white[8];                    // 白类均值(原始值)
+    uint8_t ref_black[8];              // 参考黑场 (标定值，漂移限制基准)
+    uint8_t ref_white[8];              // 参考白场 (标定值，漂移限制基准)
+    uint8_t threshold[8];              // 数字化阈值 (原始值 >= 阈值为白)
+    uint8_t valid[8];                  // 通道有效 (黑白均值差 >= GARY_CAL_MIN_SPAN)
+    uint32_t black_count[8];           // 归入黑类的样本数
+    uint32_t white_count[8];           // 归入白类的样本数
+    uint32_t clamp_count;              // 均值触及漂移限制的次数
+    uint32_t lut_rebuilds;             // 按跟踪结果重建归一化查找表的通道次数 (gary_app统计)
+} Gary_Threshold_t;
+
+// 全局自适应阈值 (gary_task按采样率更新)
+extern Gary_Threshold_t gary_threshold;
+
+/**
+ * @brief 自适应阈值初始化函数 (使能状态取GARY_ADAPT_ENABLE)
+ */
+void Threshold_Init(Gary_Threshold_t* th, const uint8_t* black, const uint8_t* white);
+
+/**
+ * @brief 以标定值重置两类均值和漂移基准 (保持使能状态)
+ */
+void Threshold_Reset(Gary_Threshold_t* th, const uint8_t* black, const uint8_t* white);
+
+/**
+ * @brief 逐帧更新两类均值和阈值
+ */
+void Threshold_Update(Gary_Threshold_t* th, const uint8_t* raw);
+
+#endif
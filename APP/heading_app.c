@@ -0,0 +1,119 @@
+/**
+ * @file heading_app.c
+ * @brief 航向模块实现 - 连续(解卷绕)航向、陀螺仪零偏估计与漂移统计
+ * @note 1. 解卷绕：相邻两次偏航角差值折算到±180度后累加，航向连续，整圈数单独给出
+ *       2. 零偏：编码器轮速持续为0超过HEADING_STILL_SETTLE_MS后，陀螺仪GZ低通为零偏，
+ *          同时按偏航角变化估计漂移率
+ *       3. 静止期间偏航角变化全部视为漂移，不计入航向；运动期间按漂移率扣除
+ *       航向由imu_task在每个新样本后更新，角度环、速度规划等从这里取航向和角速度。
+ */
+#include "heading_app.h"
+
+Heading_Data_t heading_data;
+
+/**
+ * @brief 航向初始化函数
+ * @param hd 航向数据指针
+ */
+void Heading_Init(Heading_Data_t* hd) {
+    if (hd == NULL) return;
+
+    memset(hd, 0, sizeof(*hd));
+}
+
+/**
+ * @brief 限幅到±HEADING_BIAS_MAX
+ */
+static float Heading_ClampBias(float v) {
+    if (v > HEADING_BIAS_MAX) return HEADING_BIAS_MAX;
+    if (v < -HEADING_BIAS_MAX) return -HEADING_BIAS_MAX;
+    return v;
+}
+
+/**
+ * @brief 航向更新函数
+ * @param hd 航向数据指针
+ * @param yaw IMU偏航角(度，±180)
+ * @param gz IMU Z轴角速度(°/s)
+ * @param still 1: 编码器轮速均为0
+ * @param sample_ms IMU采样时间(ms)
+ */
+void Heading_Update(Heading_Data_t* hd, float yaw, float gz, uint8_t still, uint32_t sample_ms) {
+    if (hd == NULL) return;
+
+    // 首个样本：以当前偏航角为起点
+    if (hd->update_count++ == 0) {
+        hd->heading = yaw;
+        hd->turns = 0;
+        hd->prev_yaw = yaw;
+        hd->prev_time = sample_ms;
+        hd->still_since = sample_ms;
+        hd->still = still;
+        hd->yaw_rate = gz;
+        return;
+    }
+
+    uint32_t dt_ms = sample_ms - hd->prev_time;
+    float dt = (float)dt_ms * 0.001f;
+    float dyaw = yaw - hd->prev_yaw;
+    if (dyaw > 180.0f) dyaw -= 360.0f;
+    if (dyaw < -180.0f) dyaw += 360.0f;
+    hd->prev_yaw = yaw;
+    hd->prev_time = sample_ms;
+
+    // 1. 静止判定 (开始静止后等待HEADING_STILL_SETTLE_MS，避开刹车晃动)
+    if (still && !hd->still) hd->still_since = sample_ms;
+    hd->still = still;
+    uint8_t settled = still && (sample_ms - hd->still_since >= HEADING_STILL_SETTLE_MS);
+
+    if (dt_ms == 0 || dt_ms > HEADING_SAMPLE_GAP_MS) {
+        hd->yaw_rate = gz - hd->gyro_bias;  // 采样间隔异常，只更新角速度
+        return;
+    }
+
+    // 2. 零偏与漂移率估计，静止期间偏航角变化不计入航向
+    if (settled) {
+        hd->gyro_bias = Heading_ClampBias(hd->gyro_bias + HEADING_BIAS_RATE * (gz - hd->gyro_bias));
+        hd->drift_rate = Heading_ClampBias(hd->drift_rate + HEADING_BIAS_RATE * (dyaw / dt - hd->drift_rate));
+        hd->bias_valid = 1;
+        hd->drift_rejected += dyaw;
+        hd->still_time_ms += dt_ms;
+    } else if (still) {
+        hd->drift_rejected += dyaw;  // 刚停下的等待期同样不计入
+    } else {
+        // 3. 运动：累加偏航角变化并扣除漂移
+        float correction = hd->bias_valid ? hd->drift_rate * dt : 0.0f;
+        hd->heading += dyaw - correction;
+        hd->drift_corrected += correction;
+    }
+
+    hd->yaw_rate = gz - hd->gyro_bias;
+    hd->turns = (int32_t)floorf((hd->heading + 180.0f) / 360.0f);
+}
+
+/**
+ * @brief 将当前航向置零 (保留零偏和漂移估计)
+ * @param hd 航向数据指针
+ */
+void Heading_Zero(Heading_Data_t* hd) {
+    if (hd == NULL) return;
+
+    hd->heading = 0.0f;
+    hd->turns = 0;
+    hd->drift_rejected = 0.0f;
+    hd->drift_corrected = 0.0f;
+}
+
+/**
+ * @brief 获取连续航向(度)
+ */
+float Heading_Get(const Heading_Data_t* hd) {
+    return (hd != NULL) ? hd->heading : 0.0f;
+}
+
+/**
+ * @brief 获取去零偏偏航角速度(°/s)
+ */
+float Heading_GetYawRate(const Heading_Data_t* hd) {
+    return (hd != NULL) ? hd->yaw_rate : 0.0f;
+}
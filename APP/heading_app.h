@@ -0,0 +1,59 @@
+/**
+ * @file heading_app.h
+ * @brief 航向模块头文件 - 连续(解卷绕)航向、陀螺仪零偏估计与漂移统计
+ */
+#ifndef HEADING_APP_H
+#define HEADING_APP_H
+
+#include "mydefine.h"
+
+// 航向配置参数已迁移到mydefine.h统一管理
+
+// 航向数据结构
+typedef struct {
+    float heading;                 // 连续航向(度)，不在±180度处跳变，逆时针为正
+    int32_t turns;                 // 整圈数 (heading每跨过±180+360k度变化一次)
+    float yaw_rate;                // 去零偏后的偏航角速度(°/s)
+    float gyro_bias;               // 陀螺仪Z轴零偏估计(°/s)，静止时更新
+    float drift_rate;              // 静止时偏航角漂移率估计(°/s)，运动时从航向中扣除
+
+    uint8_t still;                 // 当前静止标志 (编码器轮速均为0)
+    uint8_t bias_valid;            // 零偏已在静止时估计过
+    float prev_yaw;                // 上次IMU偏航角(度，±180)
+    uint32_t prev_time;            // 上次IMU采样时间(ms)
+    uint32_t still_since;          // 本次静止开始时间(ms)
+
+    float drift_rejected;          // 静止期间被拒绝的偏航角变化累计(度)
+    float drift_corrected;         // 运动期间扣除的漂移累计(度)
+    uint32_t still_time_ms;        // 累计有效静止时间(ms)
+    uint32_t update_count;         // 处理的IMU采样数
+} Heading_Data_t;
+
+extern Heading_Data_t heading_data; // 全局航向数据
+
+/**
+ * @brief 航向初始化函数
+ */
+void Heading_Init(Heading_Data_t* hd);
+
+/**
+ * @brief 航向更新函数 - 每个新IMU样本调用一次
+ */
+void Heading_Update(Heading_Data_t* hd, float yaw, float gz, uint8_t still, uint32_t sample_ms);
+
+/**
+ * @brief 将当前航向置零 (保留零偏和漂移估计)
+ */
+void Heading_Zero(Heading_Data_t* hd);
+
+/**
+ * @brief 获取连续航向(度)
+ */
+float Heading_Get(const Heading_Data_t* hd);
+
+/**
+ * @brief 获取去零偏偏航角速度(°/s)
+ */
+float Heading_GetYawRate(const Heading_Data_t* hd);
+
+#endif
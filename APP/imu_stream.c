@@ -0,0 +1,152 @@
+/**
+ * @file imu_stream.c
+ * @brief IMU串口流模块实现 - USART1循环DMA接收与维特协议帧扫描
+ *
+ * DMA缓冲区即环形缓冲区：写指针由DMA剩余计数得到，读指针由imu_task推进，
+ * 不使用半满/完成中断。扫描器只在帧头0x55处校验11字节，校验失败前移1字节，
+ * 重新同步只移动读指针，无需像WitSerialDataIn那样逐字节memcpy移位整个缓冲区。
+ */
+#include "imu_stream.h"
+
+#define IMU_STREAM_MASK       (IMU_STREAM_BUF_SIZE - 1)
+
+#if (IMU_STREAM_BUF_SIZE & IMU_STREAM_MASK) != 0
+#error "IMU_STREAM_BUF_SIZE必须为2的幂"
+#endif
+
+static uint8_t imu_stream_buf[IMU_STREAM_BUF_SIZE]; // DMA循环接收缓冲区
+static uint16_t imu_stream_rd = 0;                   // 扫描读指针
+static uint16_t imu_stream_wr = 0;                   // 上次轮询时的DMA写指针
+static uint32_t imu_stream_frame_us = 0;             // 当前帧开始到达时刻(us)
+static IMU_Stream_Stats_t imu_stream_stats;
+
+/**
+ * @brief 启动USART1循环DMA接收
+ * @return 1-成功，0-失败
+ */
+uint8_t IMU_Stream_Start(void)
+{
+    imu_stream_rd = 0;
+    imu_stream_wr = 0;
+    memset(&imu_stream_stats, 0, sizeof(imu_stream_stats));
+
+    if (HAL_UART_Receive_DMA(&huart1, imu_stream_buf, IMU_STREAM_BUF_SIZE) != HAL_OK) {
+        return 0;
+    }
+    // 轮询读取，关闭半满/完成中断 (保留DMA传输错误中断)
+    __HAL_DMA_DISABLE_IT(&hdma_usart1_rx, DMA_IT_HT | DMA_IT_TC);
+
+    imu_stream_stats.running = 1;
+    return 1;
+}
+
+/**
+ * @brief 串口流轮询函数
+ * 按IMU输出速率200Hz、每样本3帧计算，10ms内约66字节，缓冲区可容纳约70ms积压
+ */
+void IMU_Stream_Poll(void)
+{
+    uint16_t wr, avail;
+    uint8_t frame[IMU_FRAME_LEN];
+    const uint8_t *p_frame;
+    uint8_t sum, i;
+    uint32_t now_us;
+
+    if (!imu_stream_stats.running) {
+        return;
+    }
+
+    // 溢出只统计并清除，DMA继续接收 (丢失的字节由帧校验重新同步)
+    if (__HAL_UART_GET_FLAG(&huart1, UART_FLAG_ORE)) {
+        __HAL_UART_CLEAR_OREFLAG(&huart1);
+        imu_stream_stats.overruns++;
+    }
+
+    now_us = Perf_GetMicros();
+    wr = (uint16_t)(IMU_STREAM_BUF_SIZE - __HAL_DMA_GET_COUNTER(&hdma_usart1_rx)) & IMU_STREAM_MASK;
+    imu_stream_stats.bytes += (uint16_t)(wr - imu_stream_wr) & IMU_STREAM_MASK;
+    imu_stream_wr = wr;
+
+    avail = (uint16_t)(wr - imu_stream_rd) & IMU_STREAM_MASK;
+    if (avail > imu_stream_stats.max_backlog) {
+        imu_stream_stats.max_backlog = avail;
+    }
+
+    while (avail >= IMU_FRAME_LEN) {
+        if (imu_stream_buf[imu_stream_rd] != IMU_FRAME_HEAD) {
+            imu_stream_rd = (imu_stream_rd + 1) & IMU_STREAM_MASK;
+            avail--;
+            imu_stream_stats.skipped_bytes++;
+            continue;
+        }
+
+        // 帧不跨越缓冲区末尾时直接在DMA缓冲区上校验，跨越时拷贝到临时帧
+        if (imu_stream_rd + IMU_FRAME_LEN <= IMU_STREAM_BUF_SIZE) {
+            p_frame = &imu_stream_buf[imu_stream_rd];
+        } else {
+            for (i = 0; i < IMU_FRAME_LEN; i++) {
+                frame[i] = imu_stream_buf[(imu_stream_rd + i) & IMU_STREAM_MASK];
+            }
+            p_frame = frame;
+        }
+
+        sum = 0;
+        for (i = 0; i < IMU_FRAME_LEN - 1; i++) {
+            sum += p_frame[i];
+        }
+        if (sum != p_frame[IMU_FRAME_LEN - 1]) {
+            // 伪帧头或帧损坏：只前移1字节，从下一个0x55重新同步
+            imu_stream_rd = (imu_stream_rd + 1) & IMU_STREAM_MASK;
+            avail--;
+            imu_stream_stats.checksum_errors++;
+            imu_stream_stats.skipped_bytes++;
+            continue;
+        }
+
+        // 帧开始到达时刻：当前时刻减去其后已接收字节的传输时间 (每字节10位)
+        imu_stream_frame_us = now_us - (uint32_t)(((uint64_t)avail * 10000000U) / IMU_UART_BAUD);
+        WitSerialFrameIn(p_frame);
+        imu_stream_rd = (imu_stream_rd + IMU_FRAME_LEN) & IMU_STREAM_MASK;
+        avail -= IMU_FRAME_LEN;
+        imu_stream_stats.frames++;
+        imu_stream_stats.last_frame_tick = HAL_GetTick();
+    }
+}
+
+/**
+ * @brief 维特SDK串口写函数
+ * @param p_ucData 待发送数据
+ * @param uiLen 数据长度
+ */
+void IMU_Stream_Write(uint8_t *p_ucData, uint32_t uiLen)
+{
+    HAL_UART_Transmit(&huart1, p_ucData, (uint16_t)uiLen, IMU_COMM_TIMEOUT);
+}
+
+/**
+ * @brief 获取当前正在解析的帧的开始到达时刻
+ * @return 时间戳(us)
+ */
+uint32_t IMU_Stream_GetFrameUs(void)
+{
+    return imu_stream_frame_us;
+}
+
+/**
+ * @brief 获取串口流统计
+ */
+const IMU_Stream_Stats_t* IMU_Stream_GetStats(void)
+{
+    return &imu_stream_stats;
+}
+
+/**
+ * @brief 清除串口流统计 (保留运行状态)
+ */
+void IMU_Stream_ResetStats(void)
+{
+    uint8_t running = imu_stream_stats.running;
+
+    memset(&imu_stream_stats, 0, sizeof(imu_stream_stats));
+    imu_stream_stats.running = running;
+}
@@ -0,0 +1,53 @@
+/**
+ * @file imu_stream.h
+ * @brief IMU串口流模块头文件 - USART1循环DMA接收JY901S主动输出帧，环形扫描解析维特协议
+ */
+#ifndef IMU_STREAM_H
+#define IMU_STREAM_H
+
+#include "mydefine.h"
+
+// 串口流配置参数已迁移到mydefine.h统一管理
+
+#define IMU_FRAME_HEAD        0x55         // 维特标准协议帧头
+#define IMU_FRAME_LEN         11           // 帧长: 帧头+类型+8字节数据+校验和
+
+// 串口流统计数据结构
+typedef struct {
+    uint8_t running;               // DMA接收已启动
+    uint32_t bytes;                // 已扫描字节数
+    uint32_t frames;               // 校验通过的帧数
+    uint32_t checksum_errors;      // 校验和错误次数 (错误帧只前移1字节重新同步)
+    uint32_t skipped_bytes;        // 重新同步丢弃的字节数
+    uint32_t overruns;             // 串口溢出(ORE)次数
+    uint16_t max_backlog;          // 单次轮询最大积压字节数 (接近缓冲区长度说明轮询过慢)
+    uint32_t last_frame_tick;      // 最近一帧时间(ms)
+} IMU_Stream_Stats_t;
+
+/**
+ * @brief 启动USART1循环DMA接收
+ */
+uint8_t IMU_Stream_Start(void);
+
+/**
+ * @brief 串口流轮询函数 - 扫描DMA环形缓冲区中的新数据并送入维特SDK
+ */
+void IMU_Stream_Poll(void);
+
+/**
+ * @brief 维特SDK串口写函数 (寄存器读写指令经USART1发送)
+ */
+void IMU_Stream_Write(uint8_t *p_ucData, uint32_t uiLen);
+
+/**
+ * @brief 获取当前正在解析的帧的开始到达时刻(us)，在回调中调用
+ */
+uint32_t IMU_Stream_GetFrameUs(void);
+
+/**
+ * @brief 获取/清除串口流统计
+ */
+const IMU_Stream_Stats_t* IMU_Stream_GetStats(void);
+void IMU_Stream_ResetStats(void);
+
+#endif
@@ -0,0 +1,168 @@
+/**
+ * @file line_classifier.c
+ * @brief 循线状态时域分类模块实现 - 多帧滞回/去抖的稳定循线状态与路口事件
+ * @note Gary_DetectLineState()逐帧独立判定，单帧噪声就会在左T/路口/急剧左偏之间跳变。
+ *       本模块按采样率逐帧更新，只依赖输入序列，不访问硬件和时钟：
+ *       1. 偏差滞回：本帧与稳定状态都属于偏移类(中央/轻微/中度/急剧)时，
+ *          偏差须越过判定阈值GARY_STATE_HYST才切换档位
+ *       2. 证据分数：本帧状态分数+1，其余状态-1，上限LINE_CLASS_WINDOW
+ *       3. 切换条件：候选状态分数≥LINE_CLASS_ENTER、当前稳定状态分数≤LINE_CLASS_EXIT，
+ *          且稳定状态已保持LINE_CLASS_MIN_DWELL帧
+ *       4. 稳定状态切换时按新旧状态置位事件位掩码
+ */
+#include "line_classifier.h"
+
+Line_Classifier_t line_classifier;
+
+/**
+ * @brief 分类器初始化函数
+ * @param cls 分类器指针
+ */
+void Classifier_Init(Line_Classifier_t* cls) {
+    if (cls == NULL) return;
+
+    memset(cls, 0, sizeof(*cls));
+    cls->stable = LINE_LOST;
+    cls->frame = LINE_LOST;
+    cls->score[LINE_LOST] = LINE_CLASS_WINDOW;
+    cls->confidence = 1.0f;
+}
+
+/**
+ * @brief 偏移类状态 -> 带符号档位 (右偏为正，与偏差符号一致)
+ * @retval 1: 偏移类状态, 0: 非偏移类(丢线/路口等)
+ */
+static uint8_t Classifier_OffsetLevel(Gary_LineState_t state, int8_t* level) {
+    switch (state) {
+        case LINE_CENTER:         *level = 0;  return 1;
+        case LINE_SLIGHT_RIGHT:   *level = 1;  return 1;
+        case LINE_MODERATE_RIGHT: *level = 2;  return 1;
+        case LINE_SHARP_RIGHT:    *level = 3;  return 1;
+        case LINE_SLIGHT_LEFT:    *level = -1; return 1;
+        case LINE_MODERATE_LEFT:  *level = -2; return 1;
+        case LINE_SHARP_LEFT:     *level = -3; return 1;
+        default:                  return 0;
+    }
+}
+
+/**
+ * @brief 带符号档位 -> 偏移类状态
+ */
+static Gary_LineState_t Classifier_LevelToState(int8_t level) {
+    static const Gary_LineState_t states[7] = {
+        LINE_SHARP_LEFT, LINE_MODERATE_LEFT, LINE_SLIGHT_LEFT, LINE_CENTER,
+        LINE_SLIGHT_RIGHT, LINE_MODERATE_RIGHT, LINE_SHARP_RIGHT
+    };
+    return states[level + 3];
+}
+
+/**
+ * @brief 档位p与p+1之间的偏差判定阈值 (p取-3到2)
+ */
+static float Classifier_Boundary(int8_t p) {
+    static const float th[3] = {GARY_CENTER_THRESHOLD, GARY_SLIGHT_THRESHOLD, GARY_MODERATE_THRESHOLD};
+    return (p >= 0) ? th[p] : -th[-p - 1];
+}
+
+/**
+ * @brief 偏差滞回 - 从稳定档位出发，偏差越过阈值±GARY_STATE_HYST才换档
+ */
+static Gary_LineState_t Classifier_ApplyHysteresis(Gary_LineState_t stable, Gary_LineState_t raw, float error) {
+    int8_t p, raw_level;
+
+    if (!Classifier_OffsetLevel(stable, &p) || !Classifier_OffsetLevel(raw, &raw_level)) {
+        return raw;
+    }
+
+    while (p < 3 && error > Classifier_Boundary(p) + GARY_STATE_HYST) p++;
+    while (p > -3 && error < Classifier_Boundary(p - 1) - GARY_STATE_HYST) p--;
+
+    return Classifier_LevelToState(p);
+}
+
+/**
+ * @brief 稳定状态切换时生成事件
+ */
+static void Classifier_EmitEvents(Line_Classifier_t* cls, uint8_t from, uint8_t to) {
+    uint8_t evt = 0;
+
+    if (to == LINE_INTERSECTION) evt |= LINE_EVT_INTERSECTION_ENTER;
+    if (from == LINE_INTERSECTION) evt |= LINE_EVT_INTERSECTION_LEAVE;
+    if (to == LINE_T_LEFT) evt |= LINE_EVT_T_LEFT;
+    if (to == LINE_T_RIGHT) evt |= LINE_EVT_T_RIGHT;
+    if (to == LINE_LOST) evt |= LINE_EVT_LINE_LOST;
+    if (from == LINE_LOST) evt |= LINE_EVT_LINE_FOUND;
+
+    for (uint8_t i = 0; i < LINE_EVT_NUM; i++) {
+        if (evt & (1U << i)) cls->event_count[i]++;
+    }
+    cls->events |= evt;
+}
+
+/**
+ * @brief 分类器逐帧更新
+ * @param cls 分类器指针
+ * @param raw 单帧循线状态 (Gary_LineState_t，Gary_DetectLineState输出)
+ * @param error 本帧位置偏差(±4.0)，用于偏移类状态滞回
+ * @retval 稳定状态 (Gary_LineState_t)
+ */
+uint8_t Classifier_Update(Line_Classifier_t* cls, uint8_t raw, float error) {
+    if (cls == NULL) return raw;
+
+    // 寻线是丢线恢复期间的显示状态，按丢线统计证据
+    if (raw == LINE_SEARCHING || raw >= LINE_CLASS_STATE_NUM) raw = LINE_LOST;
+
+    uint8_t frame = Classifier_ApplyHysteresis((Gary_LineState_t)cls->stable, (Gary_LineState_t)raw, error);
+    cls->frame = frame;
+
+    // 1. 证据分数更新，同时找出分数最高的候选状态(并列时保持稳定状态)
+    uint8_t cand = cls->stable;
+    for (uint8_t s = 0; s < LINE_CLASS_STATE_NUM; s++) {
+        if (s == frame) {
+            if (cls->score[s] < LINE_CLASS_WINDOW) cls->score[s]++;
+        } else if (cls->score[s] > 0) {
+            cls->score[s]--;
+        }
+        if (cls->score[s] > cls->score[cand]) cand = s;
+    }
+
+    // 2. 满足分数滞回和最小保持帧数时切换稳定状态
+    if (cand != cls->stable
+        && cls->dwell >= LINE_CLASS_MIN_DWELL
+        && cls->score[cand] >= LINE_CLASS_ENTER
+        && cls->score[cls->stable] <= LINE_CLASS_EXIT) {
+        Classifier_EmitEvents(cls, cls->stable, cand);
+        cls->stable = cand;
+        cls->dwell = 0;
+    }
+
+    if (cls->dwell < 0xFFFF) cls->dwell++;
+    cls->confidence = (float)cls->score[cls->stable] * (1.0f / (float)LINE_CLASS_WINDOW);
+
+    return cls->stable;
+}
+
+/**
+ * @brief 读取并清除待处理事件
+ * @retval 事件位掩码 (LINE_EVT_*)
+ */
+uint8_t Classifier_TakeEvents(Line_Classifier_t* cls) {
+    if (cls == NULL) return 0;
+
+    uint8_t evt = cls->events;
+    cls->events = 0;
+    return evt;
+}
+
+/**
+ * @brief 获取事件名称
+ * @param index 事件位序号 (0 到 LINE_EVT_NUM-1)
+ */
+const char* Classifier_GetEventName(uint8_t index) {
+    static const char* names[LINE_EVT_NUM] = {
+        "进入路口", "离开路口", "左T路口", "右T路口", "丢线", "找回线"
+    };
+
+    if (index >= LINE_EVT_NUM) return "未知";
+    return names[index];
+}
@@ -0,0 +1,57 @@
+/**
+ * @file line_classifier.h
+ * @brief 循线状态时域分类模块头文件 - 多帧滞回/去抖的稳定循线状态与路口事件
+ */
+#ifndef LINE_CLASSIFIER_H
+#define LINE_CLASSIFIER_H
+
+#include "mydefine.h"
+
+// 时域分类配置参数已迁移到mydefine.h统一管理
+
+// 循线事件位掩码 (稳定状态切换时置位，读取后清除)
+#define LINE_EVT_INTERSECTION_ENTER  (1U << 0)   // 进入交叉路口
+#define LINE_EVT_INTERSECTION_LEAVE  (1U << 1)   // 离开交叉路口
+#define LINE_EVT_T_LEFT              (1U << 2)   // 确认左T型路口
+#define LINE_EVT_T_RIGHT             (1U << 3)   // 确认右T型路口
+#define LINE_EVT_LINE_LOST           (1U << 4)   // 确认丢线
+#define LINE_EVT_LINE_FOUND          (1U << 5)   // 丢线后重新确认有线
+#define LINE_EVT_NUM                 6
+
+#define LINE_CLASS_STATE_NUM         12          // 状态数，与Gary_LineState_t一致
+
+// 时域分类器数据结构
+typedef struct {
+    uint8_t stable;                    // 稳定状态 (Gary_LineState_t，去抖后输出)
+    uint8_t frame;                     // 本帧经偏差滞回修正后的状态 (Gary_LineState_t)
+    uint8_t score[LINE_CLASS_STATE_NUM]; // 各状态证据分数 (命中+1，未命中-1，上限LINE_CLASS_WINDOW)
+    uint16_t dwell;                    // 稳定状态已保持帧数
+    float confidence;                  // 稳定状态置信度 (0.0-1.0)
+    uint8_t events;                    // 待读取事件位掩码
+    uint32_t event_count[LINE_EVT_NUM];// 各事件累计次数
+} Line_Classifier_t;
+
+// 全局循线状态分类器 (gary_task按采样率更新)
+extern Line_Classifier_t line_classifier;
+
+/**
+ * @brief 分类器初始化函数
+ */
+void Classifier_Init(Line_Classifier_t* cls);
+
+/**
+ * @brief 分类器逐帧更新 - 输入单帧状态与位置偏差，返回稳定状态
+ */
+uint8_t Classifier_Update(Line_Classifier_t* cls, uint8_t raw, float error);
+
+/**
+ * @brief 读取并清除待处理事件
+ */
+uint8_t Classifier_TakeEvents(Line_Classifier_t* cls);
+
+/**
+ * @brief 获取事件名称
+ */
+const char* Classifier_GetEventName(uint8_t index);
+
+#endif
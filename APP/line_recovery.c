@@ -0,0 +1,179 @@
+/**
+ * @file line_recovery.c
+ * @brief 丢线恢复模块实现 - 记忆最后偏差方向的丢线转向/搜索状态机
+ * @note 丢线(line_bits==0)时偏差算法输出0.0，循线环会命令直行，
+ *       过冲急弯时小车从弯道外侧冲出。本模块在循线环之后接管(v, ω)：
+ *       1. HOLD:   丢线确认期内保持最后角速度，滤除虚线/反光造成的短暂丢线
+ *       2. STEER:  向最后偏差一侧以不小于LINE_RECOVER_OMEGA的角速度转向，线速度按比例降低
+ *       3. SEARCH: 转向超时后原地旋转(LINE_SEARCH_SPEED为0)或半径逐渐增大的螺旋搜索
+ *       4. FAILED: 搜索超时停车，重新检测到线后自动恢复循线
+ *       任一状态下重新检测到线即回到TRACKING，并记录重新找到线耗时
+ */
+#include "line_recovery.h"
+
+Line_Recovery_t line_recovery;
+
+/**
+ * @brief 丢线恢复初始化函数
+ * @param rec 状态机指针
+ */
+void Recovery_Init(Line_Recovery_t* rec) {
+    if (rec == NULL) return;
+
+    Recovery_Reset(rec);
+    Recovery_ClearStats(rec);
+}
+
+/**
+ * @brief 复位到正常循线状态
+ * @param rec 状态机指针
+ * @note 只复位状态与记忆的偏差，统计数据保留
+ */
+void Recovery_Reset(Line_Recovery_t* rec) {
+    if (rec == NULL) return;
+
+    rec->state = RECOVERY_TRACKING;
+    rec->last_error = 0.0f;
+    rec->last_omega = 0.0f;
+    rec->dir = 0.0f;
+    rec->lost_tick = 0;
+    rec->state_tick = 0;
+    rec->v_target = 0.0f;
+    rec->omega = 0.0f;
+}
+
+/**
+ * @brief 清除统计数据
+ * @param rec 状态机指针
+ */
+void Recovery_ClearStats(Line_Recovery_t* rec) {
+    if (rec == NULL) return;
+
+    rec->lost_count = 0;
+    rec->fail_count = 0;
+    rec->last_reacquire_ms = 0;
+    rec->max_reacquire_ms = 0;
+    rec->total_reacquire_ms = 0;
+    rec->reacquire_count = 0;
+}
+
+/**
+ * @brief 由最后有效偏差/角速度确定恢复转向方向
+ * @retval +1: 逆时针(向左), -1: 顺时针(向右), 0: 丢线时基本正对线，无法判断
+ * @note 与PID_Line_Calc符号一致：偏差为正时ω为负
+ */
+static float Recovery_GetDirection(const Line_Recovery_t* rec) {
+    if (rec->last_error >= LINE_RECOVER_ERROR_MIN) return -1.0f;
+    if (rec->last_error <= -LINE_RECOVER_ERROR_MIN) return 1.0f;
+
+    // 偏差很小时参考最后角速度 (例如模拟量质心刚越过中心)
+    if (rec->last_omega >= LINE_RECOVER_OMEGA_MIN) return 1.0f;
+    if (rec->last_omega <= -LINE_RECOVER_OMEGA_MIN) return -1.0f;
+
+    return 0.0f;
+}
+
+/**
+ * @brief 丢线恢复周期更新函数
+ * @param rec 状态机指针
+ * @param line_found 本周期是否检测到线
+ * @param gary_error 灰度位置偏差(±4.0)，仅在检测到线时有效
+ * @param omega_track 循线环输出的角速度指令(rad/s)，仅在检测到线时有效
+ * @param v_nominal 正常循线时的线速度目标(m/s)
+ * @param now_ms 当前时间(ms)
+ * @note 结果写入rec->v_target和rec->omega
+ */
+void Recovery_Update(Line_Recovery_t* rec, uint8_t line_found, float gary_error,
+                     float omega_track, float v_nominal, uint32_t now_ms) {
+    if (rec == NULL) return;
+
+    // 检测到线：记录恢复耗时并回到正常循线
+    if (line_found) {
+        if (rec->state != RECOVERY_TRACKING && rec->state != RECOVERY_HOLD) {
+            uint32_t elapsed = now_ms - rec->lost_tick;
+            rec->last_reacquire_ms = elapsed;
+            if (elapsed > rec->max_reacquire_ms) rec->max_reacquire_ms = elapsed;
+            rec->total_reacquire_ms += elapsed;
+            rec->reacquire_count++;
+        }
+        rec->state = RECOVERY_TRACKING;
+        rec->last_error = gary_error;
+        rec->last_omega = omega_track;
+        rec->v_target = v_nominal;
+        rec->omega = omega_track;
+        return;
+    }
+
+    // 刚丢线：锁定转向方向
+    if (rec->state == RECOVERY_TRACKING) {
+        rec->state = RECOVERY_HOLD;
+        rec->lost_tick = now_ms;
+        rec->state_tick = now_ms;
+        rec->dir = Recovery_GetDirection(rec);
+    }
+
+    // 状态超时转移
+    if (rec->state == RECOVERY_HOLD && (now_ms - rec->state_tick) >= LINE_LOST_CONFIRM_MS) {
+        rec->state = RECOVERY_STEER;
+        rec->state_tick = now_ms;
+        rec->lost_count++;
+    }
+    if (rec->state == RECOVERY_STEER && (now_ms - rec->state_tick) >= LINE_RECOVER_STEER_MS) {
+        rec->state = RECOVERY_SEARCH;
+        rec->state_tick = now_ms;
+    }
+    if (rec->state == RECOVERY_SEARCH && (now_ms - rec->state_tick) >= LINE_SEARCH_TIMEOUT_MS) {
+        rec->state = RECOVERY_FAILED;
+        rec->state_tick = now_ms;
+        rec->fail_count++;
+    }
+
+    // 各状态输出
+    switch (rec->state) {
+        case RECOVERY_HOLD:
+            rec->v_target = v_nominal;
+            rec->omega = rec->last_omega;
+            break;
+
+        case RECOVERY_STEER: {
+            float mag = fabsf(rec->last_omega);
+            if (mag < LINE_RECOVER_OMEGA) mag = LINE_RECOVER_OMEGA;
+            rec->v_target = v_nominal * LINE_RECOVER_SPEED_SCALE;
+            rec->omega = rec->dir * mag;  // 方向未知时降速直行
+            break;
+        }
+
+        case RECOVERY_SEARCH: {
+            // 线速度随时间线性增大，旋转半径 v/ω 逐渐扩大形成螺旋
+            float t = (float)(now_ms - rec->state_tick) / (float)LINE_SEARCH_TIMEOUT_MS;
+            float dir = (rec->dir != 0.0f) ? rec->dir : 1.0f;
+            rec->v_target = LINE_SEARCH_SPEED * t;
+            rec->omega = dir * LINE_SEARCH_OMEGA;
+            break;
+        }
+
+        case RECOVERY_FAILED:
+        default:
+            rec->v_target = 0.0f;
+            rec->omega = 0.0f;
+            break;
+    }
+}
+
+/**
+ * @brief 检查是否处于丢线恢复中
+ * @retval 1: 丢线(含确认期), 0: 正常循线
+ */
+uint8_t Recovery_IsActive(const Line_Recovery_t* rec) {
+    return (rec != NULL && rec->state != RECOVERY_TRACKING) ? 1 : 0;
+}
+
+/**
+ * @brief 获取状态名称
+ */
+const char* Recovery_GetStateName(Recovery_State_t state) {
+    static const char* names[] = {"循线", "丢线确认", "转向找线", "旋转搜索", "搜索失败"};
+
+    if (state > RECOVERY_FAILED) return "未知";
+    return names[state];
+}
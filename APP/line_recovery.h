@@ -0,0 +1,73 @@
+/**
+ * @file line_recovery.h
+ * @brief 丢线恢复模块头文件 - 记忆最后偏差方向的丢线转向/搜索状态机
+ */
+#ifndef LINE_RECOVERY_H
+#define LINE_RECOVERY_H
+
+#include "mydefine.h"
+
+// 丢线恢复配置参数已迁移到mydefine.h统一管理
+
+// 恢复状态枚举
+typedef enum {
+    RECOVERY_TRACKING = 0,   // 正常循线
+    RECOVERY_HOLD,           // 丢线确认中 (保持最后角速度，滤除短暂断线)
+    RECOVERY_STEER,          // 向最后偏差一侧大角速度转向并降速
+    RECOVERY_SEARCH,         // 超时后原地旋转/螺旋搜索
+    RECOVERY_FAILED          // 搜索超时，停车等待
+} Recovery_State_t;
+
+// 丢线恢复数据结构
+typedef struct {
+    Recovery_State_t state;            // 当前状态
+    float last_error;                  // 最后一次有效位置偏差(±4.0)
+    float last_omega;                  // 最后一次有效角速度指令(rad/s)
+    float dir;                         // 恢复转向方向 (+1: 逆时针, -1: 顺时针)
+    uint32_t lost_tick;                // 丢线起始时间(ms)
+    uint32_t state_tick;               // 进入当前状态的时间(ms)
+    float v_target;                    // 输出线速度目标(m/s)
+    float omega;                       // 输出角速度指令(rad/s)
+    uint32_t lost_count;               // 丢线次数 (超过确认时间)
+    uint32_t fail_count;               // 搜索失败次数
+    uint32_t last_reacquire_ms;        // 最近一次重新找到线的耗时(ms)
+    uint32_t max_reacquire_ms;         // 最长重新找到线耗时(ms)
+    uint32_t total_reacquire_ms;       // 累计重新找到线耗时(ms)，用于求平均
+    uint32_t reacquire_count;          // 重新找到线次数
+} Line_Recovery_t;
+
+// 全局丢线恢复状态机 (pid_task中循线环与速度规划之间)
+extern Line_Recovery_t line_recovery;
+
+/**
+ * @brief 丢线恢复初始化函数 (状态与统计全部清零)
+ */
+void Recovery_Init(Line_Recovery_t* rec);
+
+/**
+ * @brief 复位到正常循线状态，保留统计 (启动时使用)
+ */
+void Recovery_Reset(Line_Recovery_t* rec);
+
+/**
+ * @brief 清除统计数据
+ */
+void Recovery_ClearStats(Line_Recovery_t* rec);
+
+/**
+ * @brief 丢线恢复周期更新函数 - 每个控制周期调用一次
+ */
+void Recovery_Update(Line_Recovery_t* rec, uint8_t line_found, float gary_error,
+                     float omega_track, float v_nominal, uint32_t now_ms);
+
+/**
+ * @brief 检查是否处于丢线恢复中
+ */
+uint8_t Recovery_IsActive(const Line_Recovery_t* rec);
+
+/**
+ * @brief 获取状态名称
+ */
+const char* Recovery_GetStateName(Recovery_State_t state);
+
+#endif
@@ -0,0 +1,134 @@
+/**
+ * @file motion_profile.c
+ * @brief 速度规划模块实现 - 加速度/加加速度受限的S曲线速度轨迹生成
+ * @note 每个控制周期在线计算，目标可随时改变：
+ *       以最大加加速度把当前加速度收回0，速度还会再变化 a|a|/(2J)，
+ *       据此求出"刚好停在目标速度"的期望加速度 a_des = sign(dv)·sqrt(2J|dv|)，
+ *       再按 ±J·dt 限制加速度变化率、按 ±A 限制加速度幅值。
+ *       速度连续、加速度连续，大阶跃时退化为梯形(恒加速段)。
+ *       速度目标非负(前进)，加速段受max_accel限制，减速段受max_decel限制；
+ *       电机可短路制动时减速度可大于加速度，弯前制动点随之后移。
+ */
+#include "motion_profile.h"
+
+Motion_Profile_t speed_profile;
+
+/**
+ * @brief 速度规划器初始化函数
+ * @param profile 规划器指针
+ * @param max_accel 最大加速度(m/s²)
+ * @param max_jerk 最大加加速度(m/s³)
+ */
+void Profile_Init(Motion_Profile_t* profile, float max_accel, float max_jerk) {
+    if (profile == NULL) return;
+
+    profile->target = 0.0f;
+    profile->v = 0.0f;
+    profile->a = 0.0f;
+    profile->active = 0;
+    Profile_SetLimits(profile, max_accel, max_jerk);
+    profile->max_decel = profile->max_accel;
+}
+
+/**
+ * @brief 设置目标速度
+ * @param profile 规划器指针
+ * @param target 目标速度(m/s)
+ */
+void Profile_SetTarget(Motion_Profile_t* profile, float target) {
+    if (profile == NULL) return;
+
+    if (target != profile->target) {
+        profile->target = target;
+        profile->active = 1;
+    }
+}
+
+/**
+ * @brief 将输出速度强制置为指定值
+ * @param profile 规划器指针
+ * @param v 输出速度(m/s)
+ */
+void Profile_Reset(Motion_Profile_t* profile, float v) {
+    if (profile == NULL) return;
+
+    profile->v = v;
+    profile->a = 0.0f;
+    profile->active = (profile->target != v);
+}
+
+/**
+ * @brief 设置加速度与加加速度限制
+ * @param profile 规划器指针
+ * @param max_accel 最大加速度(m/s²)，必须大于0
+ * @param max_jerk 最大加加速度(m/s³)，必须大于0
+ */
+void Profile_SetLimits(Motion_Profile_t* profile, float max_accel, float max_jerk) {
+    if (profile == NULL) return;
+
+    if (max_accel > 0.0f) profile->max_accel = max_accel;
+    if (max_jerk > 0.0f) profile->max_jerk = max_jerk;
+}
+
+/**
+ * @brief 设置减速度限制
+ * @param profile 规划器指针
+ * @param max_decel 最大减速度(m/s²)，必须大于0
+ */
+void Profile_SetDecel(Motion_Profile_t* profile, float max_decel) {
+    if (profile == NULL) return;
+
+    if (max_decel > 0.0f) profile->max_decel = max_decel;
+}
+
+/**
+ * @brief 速度规划周期更新函数
+ * @param profile 规划器指针
+ * @param dt 控制周期(s)
+ * @retval 本周期输出速度(m/s)
+ */
+float Profile_Update(Motion_Profile_t* profile, float dt) {
+    if (profile == NULL) return 0.0f;
+
+    float dv = profile->target - profile->v;
+    float jerk_step = profile->max_jerk * dt; // 单周期允许的加速度变化量
+
+    // 已到达目标且加速度可在一个周期内收回：直接对齐，结束过渡
+    if (fabsf(dv) < 1e-4f && fabsf(profile->a) <= jerk_step) {
+        profile->v = profile->target;
+        profile->a = 0.0f;
+        profile->active = 0;
+        return profile->v;
+    }
+
+    // 期望加速度：以最大加加速度收回加速度时恰好到达目标速度
+    // 用本周期结束时的剩余速度差计算，补偿离散控制的一拍滞后
+    float dv_left = dv - profile->a * dt;
+    float a_des = sqrtf(2.0f * profile->max_jerk * fabsf(dv_left));
+    if (dv_left < 0.0f) a_des = -a_des;
+    a_des = pid_constrain(a_des, -profile->max_decel, profile->max_accel);
+
+    // 加加速度限制
+    float a_next = pid_constrain(a_des, profile->a - jerk_step, profile->a + jerk_step);
+
+    // 梯形积分，速度曲线连续
+    float v_step = 0.5f * (profile->a + a_next) * dt;
+
+    // 末段按剩余速度差反算本周期恰好到达目标的末端加速度：
+    // 1. 反算值可一步达到、且下一周期可一步收回时直接落在目标上，结束过渡
+    // 2. 离散误差导致本周期将越过目标时，改用受加速度和加加速度限制的反算值，
+    //    限制不允许时保留少量超调，由后续周期收回，加速度不突变
+    float a_land = 2.0f * dv / dt - profile->a;
+    if (fabsf(a_land) <= jerk_step && fabsf(a_land - profile->a) <= jerk_step) {
+        a_next = a_land;
+    } else if ((dv > 0.0f && v_step > dv) || (dv < 0.0f && v_step < dv)) {
+        a_land = pid_constrain(a_land, -profile->max_decel, profile->max_accel);
+        a_next = pid_constrain(a_land, profile->a - jerk_step, profile->a + jerk_step);
+    }
+    v_step = 0.5f * (profile->a + a_next) * dt;
+
+    profile->v += v_step;
+    profile->a = a_next;
+
+    return profile->v;
+}
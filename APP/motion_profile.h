@@ -0,0 +1,56 @@
+/**
+ * @file motion_profile.h
+ * @brief 速度规划模块头文件 - 加速度/加加速度受限的S曲线速度轨迹生成
+ */
+#ifndef MOTION_PROFILE_H
+#define MOTION_PROFILE_H
+
+#include "mydefine.h"
+
+// 速度规划配置参数已迁移到mydefine.h统一管理
+
+// 速度规划器数据结构
+typedef struct {
+    float target;                      // 目标速度(m/s)
+    float v;                           // 当前输出速度(m/s)
+    float a;                           // 当前加速度(m/s²)
+    float max_accel;                   // 最大加速度(m/s²)
+    float max_decel;                   // 最大减速度(m/s²)，前进方向减速时使用
+    float max_jerk;                    // 最大加加速度(m/s³)
+    uint8_t active;                    // 过渡标志 (1: 正在向目标过渡)
+} Motion_Profile_t;
+
+// 全局线速度规划器 (命令 -> 速度规划 -> 车体速度控制)
+extern Motion_Profile_t speed_profile;
+
+/**
+ * @brief 速度规划器初始化函数
+ */
+void Profile_Init(Motion_Profile_t* profile, float max_accel, float max_jerk);
+
+/**
+ * @brief 设置目标速度 (下一周期起按限制平滑过渡)
+ */
+void Profile_SetTarget(Motion_Profile_t* profile, float target);
+
+/**
+ * @brief 将输出速度强制置为指定值，加速度清零 (启动/急停时使用)
+ */
+void Profile_Reset(Motion_Profile_t* profile, float v);
+
+/**
+ * @brief 设置加速度与加加速度限制
+ */
+void Profile_SetLimits(Motion_Profile_t* profile, float max_accel, float max_jerk);
+
+/**
+ * @brief 设置减速度限制 (默认与加速度相同)
+ */
+void Profile_SetDecel(Motion_Profile_t* profile, float max_decel);
+
+/**
+ * @brief 速度规划周期更新函数 - 每个控制周期调用一次
+ */
+float Profile_Update(Motion_Profile_t* profile, float dt);
+
+#endif
@@ -17,6 +17,52 @@ uint8_t enable = 0;            // 电机使能标志 (安全：默认禁用)
 
 Motor_t motor1,motor2; // 电机实例
 
+static uint32_t motor_stop_brake_until = 0; // 停车制动截止时间(ms)，0表示无停车制动
+
+/**
+ * @brief  写方向引脚 - 方向与缓存相同时直接返回，否则IN1/IN2经一次BSRR写入同时切换
+ * @param  motor: 电机实体指针
+ * @param  state: 目标方向 (STOP/FORWARD/BACKWARD)
+ */
+static inline void Motor_WriteDirection(Motor_t* motor, Motor_State_t state) {
+    if (motor->state == state) {
+        return;
+    }
+    motor->hw.in1_port->BSRR = motor->hw.in1_bsrr[state];
+    if (motor->hw.in2_bsrr[state] != 0) {
+        motor->hw.in2_port->BSRR = motor->hw.in2_bsrr[state];  // IN1/IN2不同端口时第二次写入
+    }
+    motor->state = state;
+}
+
+/**
+ * @brief  写STBY引脚 - 电平已正确时不写
+ * 两电机共用STBY且motor_task也会写，因此读回ODR判断而不是软件缓存
+ */
+static inline void Motor_WriteStby(GPIO_TypeDef* port, uint16_t pin, uint8_t on) {
+    if (((port->ODR & pin) != 0) != (on != 0)) {
+        port->BSRR = on ? (uint32_t)pin : ((uint32_t)pin << 16);
+    }
+}
+
+/**
+ * @brief  按速度符号写方向并写比较寄存器
+ * @param  motor: 电机实体指针
+ * @param  speed: 速度值 (已做范围检查)
+ */
+static inline void Motor_Output(Motor_t* motor, int32_t speed) {
+    if (speed > 0) {
+        Motor_WriteDirection(motor, MOTOR_STATE_FORWARD);   // IN1=0, IN2=1
+        *motor->hw.ccr = (uint32_t)speed;
+    } else if (speed < 0) {
+        Motor_WriteDirection(motor, MOTOR_STATE_BACKWARD);  // IN1=1, IN2=0
+        *motor->hw.ccr = (uint32_t)(-speed);
+    } else {
+        Motor_WriteDirection(motor, MOTOR_STATE_STOP);      // TB6612停止：IN1=0, IN2=0
+        *motor->hw.ccr = 0;
+    }
+}
+
 /**
  * @brief  电机初始化函数
  * @param motor        电机实体
@@ -54,19 +100,41 @@ int8_t Motor_Create(Motor_t* motor,
     motor->hw.stby_port = stby_port;
     motor->hw.stby_pin = stby_pin;
 
-    // 初始化电机状态
+    // CCR1~CCR4地址连续，TIM_CHANNEL_x = 0x0/0x4/0x8/0xC
+    motor->hw.ccr = &htim->Instance->CCR1 + (channel >> 2U);
+
+    // 预计算各方向的BSRR值：低16位置位，高16位复位
+    for (uint8_t s = MOTOR_STATE_STOP; s < MOTOR_STATE_ERROR; s++) {
+        uint8_t in1_set = (s == MOTOR_STATE_BACKWARD || s == MOTOR_STATE_BRAKE);
+        uint8_t in2_set = (s == MOTOR_STATE_FORWARD || s == MOTOR_STATE_BRAKE);
+        uint32_t in1 = in1_set ? in1_pin : ((uint32_t)in1_pin << 16);
+        uint32_t in2 = in2_set ? in2_pin : ((uint32_t)in2_pin << 16);
+        if (in1_port == in2_port) {
+            motor->hw.in1_bsrr[s] = in1 | in2;
+            motor->hw.in2_bsrr[s] = 0;
+        } else {
+            motor->hw.in1_bsrr[s] = in1;
+            motor->hw.in2_bsrr[s] = in2;
+        }
+    }
+
+    // 初始化电机状态 (方向缓存置为未知，强制首次写引脚)
     motor->speed = 0;
-    motor->state = MOTOR_STATE_STOP;
+    motor->state = MOTOR_STATE_ERROR;
     motor->enable = 1;
+    motor->mode = MOTOR_MODE_DRIVE;
+    motor->brake_duty = 0;
+    motor->brake_acc = 0;
+
+    // 比较寄存器预装载：新占空比在下一次更新事件生效，双电机同步写入见Motor_SetSpeedPair
+    __HAL_TIM_ENABLE_OCxPRELOAD(motor->hw.htim, motor->hw.channel);
 
     // 启动PWM
     HAL_TIM_PWM_Start(motor->hw.htim, motor->hw.channel);
 
     // 初始状态：停止
-    HAL_GPIO_WritePin(motor->hw.stby_port, motor->hw.stby_pin, GPIO_PIN_SET);  // 使能
-    HAL_GPIO_WritePin(motor->hw.in1_port, motor->hw.in1_pin, GPIO_PIN_RESET);
-    HAL_GPIO_WritePin(motor->hw.in2_port, motor->hw.in2_pin, GPIO_PIN_RESET);
-    __HAL_TIM_SET_COMPARE(motor->hw.htim, motor->hw.channel, 0);
+    Motor_WriteStby(motor->hw.stby_port, motor->hw.stby_pin, 1);  // 使能
+    Motor_Output(motor, 0);
 
     return 0;
 }
@@ -84,30 +152,169 @@ int8_t Motor_SetSpeed(Motor_t* motor, int32_t speed, uint8_t enable) {
     }
 
     // 检查速度范围
-    if (speed < -1000 || speed > 1000) {
+    if (speed < SPEED_MIN || speed > SPEED_MAX) {
         return -1;
     }
 
     // 设置使能状态
+    motor->enable = enable;
+    motor->speed = speed;
+    motor->mode = MOTOR_MODE_DRIVE;
+
+    if (!enable) {
+        // 禁用单个电机：仅停止该电机，不操作STBY引脚，避免影响另一个电机
+        Motor_Output(motor, 0);
+        return 0;
+    }
+
+    // 使能电机：确保STBY开启（但不会因为单个电机禁用而关闭）
+    Motor_WriteStby(motor->hw.stby_port, motor->hw.stby_pin, 1);
+
+    // 方向未变时只写比较寄存器
+    Motor_Output(motor, speed);
+
+    return 0;
+}
+
+/**
+ * @brief  制动调制 - motor_task中每1ms调用
+ * Σ-Δ调制：每个时隙累加制动强度，溢出的时隙短路制动，其余时隙滑行，
+ * 平均制动转矩与强度近似成正比 (电机电气时间常数远小于1ms时隙)
+ * @param  motor: 电机实体指针
+ */
+static void Motor_BrakeModulate(Motor_t* motor) {
+    if (motor->mode != MOTOR_MODE_BRAKE) {
+        return;
+    }
+    motor->brake_acc += motor->brake_duty;
+    if (motor->brake_acc >= MOTOR_BRAKE_FULL) {
+        motor->brake_acc -= MOTOR_BRAKE_FULL;
+        Motor_WriteDirection(motor, MOTOR_STATE_BRAKE);
+    } else {
+        Motor_WriteDirection(motor, MOTOR_STATE_STOP);
+    }
+}
+
+/**
+ * @brief  设置电机输出模式
+ * @param  motor: 电机实体指针
+ * @param  mode: MOTOR_MODE_DRIVE 以速度0驱动(方向引脚低，与Motor_SetSpeed(…, 0, …)相同)
+ *               MOTOR_MODE_BRAKE 满制动 (IN1=IN2=1)
+ *               MOTOR_MODE_COAST 滑行 (IN1=IN2=0)
+ * @retval 0: 成功, -1: 参数错误
+ */
+int8_t Motor_SetMode(Motor_t* motor, Motor_Mode_t mode) {
+    // 参数检查
+    if (motor == NULL) {
+        return -1;
+    }
+
+    switch (mode) {
+        case MOTOR_MODE_DRIVE:
+            return Motor_SetSpeed(motor, 0, motor->enable);
+        case MOTOR_MODE_BRAKE:
+            return Motor_Brake(motor, MOTOR_BRAKE_FULL);
+        case MOTOR_MODE_COAST:
+            motor->speed = 0;
+            motor->mode = MOTOR_MODE_COAST;
+            Motor_Output(motor, 0);
+            return 0;
+        default:
+            return -1;
+    }
+}
+
+/**
+ * @brief  部分制动
+ * 短路制动把电机动能消耗在绕组电阻上，到零速自然停止，不像反向驱动那样电流大且会反转。
+ * 制动期间PWM比较值置0，强度由motor_task按1ms时隙调制制动/滑行比例。
+ * @param  motor: 电机实体指针
+ * @param  strength: 制动强度 (0: 滑行, MOTOR_BRAKE_FULL: 满制动)
+ * @retval 0: 成功, -1: 参数错误
+ */
+int8_t Motor_Brake(Motor_t* motor, uint16_t strength) {
+    // 参数检查
+    if (motor == NULL || strength > MOTOR_BRAKE_FULL) {
+        return -1;
+    }
+
+    // 短路制动需要TB6612退出待机
+    Motor_WriteStby(motor->hw.stby_port, motor->hw.stby_pin, 1);
+
+    uint8_t entering = (motor->mode != MOTOR_MODE_BRAKE);
+    if (entering) {
+        motor->brake_acc = 0;
+    }
+    motor->speed = 0;
+    motor->mode = MOTOR_MODE_BRAKE;
+    motor->brake_duty = strength;
+    *motor->hw.ccr = 0;
+
+    // 从其他模式进入制动时立即输出第一个时隙；已在制动中只更新强度，
+    // 时隙仍由motor_task调制，避免每次刷新多累加一次改变制动比例
+    if (entering) {
+        Motor_BrakeModulate(motor);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief  双电机同步设置
+ * 比较寄存器已开启预装载，但两次CCR写入之间若恰好发生更新事件，两轮会相差一个PWM周期生效。
+ * 同一定时器时写入期间置UDIS屏蔽更新事件，计数器照常重载，两路新占空比在之后的同一次更新事件锁存。
+ * @param  left/right: 电机实体指针
+ * @param  left_speed/right_speed: 速度值 (-1000 到 +1000)
+ * @param  enable: 使能状态 (1:使能, 0:禁用)
+ * @retval 0: 成功, -1: 参数错误
+ */
+int8_t Motor_SetSpeedPair(Motor_t* left, int32_t left_speed, Motor_t* right, int32_t right_speed, uint8_t enable) {
+    // 参数检查
+    if (left == NULL || right == NULL) {
+        return -1;
+    }
+
+    TIM_TypeDef* tim = left->hw.htim->Instance;
+    uint8_t same_tim = (tim == right->hw.htim->Instance);
+    int8_t ret = 0;
+
+    if (same_tim) {
+        tim->CR1 |= TIM_CR1_UDIS;
+    }
+    if (Motor_SetSpeed(left, left_speed, enable) != 0) ret = -1;
+    if (Motor_SetSpeed(right, right_speed, enable) != 0) ret = -1;
+    if (same_tim) {
+        tim->CR1 &= ~TIM_CR1_UDIS;
+    }
+
+    return ret;
+}
+
+/**
+ * @brief  HAL路径参考实现 (原Motor_SetSpeed，仅供Motor_Bench对比)
+ */
+static int8_t Motor_SetSpeed_HAL(Motor_t* motor, int32_t speed, uint8_t enable) {
+    if (motor == NULL) {
+        return -1;
+    }
+    if (speed < SPEED_MIN || speed > SPEED_MAX) {
+        return -1;
+    }
+
     motor->enable = enable;
     motor->speed = speed;
 
     if (!enable) {
-        // 禁用单个电机：仅停止该电机，不影响STBY（避免影响另一个电机）
         motor->state = MOTOR_STATE_STOP;
         HAL_GPIO_WritePin(motor->hw.in1_port, motor->hw.in1_pin, GPIO_PIN_RESET);
         HAL_GPIO_WritePin(motor->hw.in2_port, motor->hw.in2_pin, GPIO_PIN_RESET);
         __HAL_TIM_SET_COMPARE(motor->hw.htim, motor->hw.channel, 0);
-        // 注意：不操作STBY引脚，避免影响另一个电机
         return 0;
     }
 
-    // 使能电机：确保STBY开启（但不会因为单个电机禁用而关闭）
     HAL_GPIO_WritePin(motor->hw.stby_port, motor->hw.stby_pin, GPIO_PIN_SET);
 
-    // 处理停止
     if (speed == 0) {
-        // TB6612停止：IN1=0, IN2=0, PWM=任意值
         HAL_GPIO_WritePin(motor->hw.in1_port, motor->hw.in1_pin, GPIO_PIN_RESET);
         HAL_GPIO_WritePin(motor->hw.in2_port, motor->hw.in2_pin, GPIO_PIN_RESET);
         __HAL_TIM_SET_COMPARE(motor->hw.htim, motor->hw.channel, 0);
@@ -125,22 +332,105 @@ int8_t Motor_SetSpeed(Motor_t* motor, int32_t speed, uint8_t enable) {
         motor->state = MOTOR_STATE_BACKWARD;
     }
 
-    uint16_t pwm_value = abs(speed);  // PWM值为速度绝对值
-
-    // 设置PWM占空比
-    __HAL_TIM_SET_COMPARE(motor->hw.htim, motor->hw.channel, pwm_value);
+    __HAL_TIM_SET_COMPARE(motor->hw.htim, motor->hw.channel, (uint16_t)abs(speed));
 
     return 0;
 }
 
+/**
+ * @brief  电机输出耗时基准测试
+ * 使用motor1/motor2的副本，引脚掩码清零后GPIO写入为空操作；比较寄存器为真实写入，
+ * 因此只允许在电机停止(STBY关闭)时运行，结束后恢复原比较值。
+ * @param  iterations: 每个场景的迭代次数 (每次更新两个电机)
+ */
+void Motor_Bench(uint32_t iterations) {
+    Motor_t bench[2];
+    uint32_t ccr_saved[2];
+    uint32_t start, cycles_hal_same, cycles_fast_same, cycles_hal_flip, cycles_fast_flip;
+
+    if (iterations == 0) return;
+    if (enable) {
+        my_printf(&huart2,"错误：电机运行中，请先stop\r\n");
+        return;
+    }
+
+    bench[0] = motor1;
+    bench[1] = motor2;
+    for (uint8_t i = 0; i < 2; i++) {
+        ccr_saved[i] = *bench[i].hw.ccr;
+        bench[i].hw.in1_pin = 0;
+        bench[i].hw.in2_pin = 0;
+        bench[i].hw.stby_pin = 0;
+        for (uint8_t s = MOTOR_STATE_STOP; s < MOTOR_STATE_ERROR; s++) {
+            bench[i].hw.in1_bsrr[s] = 0;
+            bench[i].hw.in2_bsrr[s] = 0;
+        }
+    }
+
+    // 场景1：同向变占空比 (PID正常运行时的典型情况)
+    start = Perf_GetCycles();
+    for (uint32_t n = 0; n < iterations; n++) {
+        int32_t speed = 300 + (int32_t)(n & 255);
+        Motor_SetSpeed_HAL(&bench[0], speed, 1);
+        Motor_SetSpeed_HAL(&bench[1], speed, 1);
+    }
+    cycles_hal_same = Perf_GetCycles() - start;
+
+    start = Perf_GetCycles();
+    for (uint32_t n = 0; n < iterations; n++) {
+        int32_t speed = 300 + (int32_t)(n & 255);
+        Motor_SetSpeedPair(&bench[0], speed, &bench[1], speed, 1);
+    }
+    cycles_fast_same = Perf_GetCycles() - start;
+
+    // 场景2：每次换向 (最坏情况，方向引脚每次都要写)
+    start = Perf_GetCycles();
+    for (uint32_t n = 0; n < iterations; n++) {
+        int32_t speed = (n & 1) ? 300 : -300;
+        Motor_SetSpeed_HAL(&bench[0], speed, 1);
+        Motor_SetSpeed_HAL(&bench[1], speed, 1);
+    }
+    cycles_hal_flip = Perf_GetCycles() - start;
+
+    start = Perf_GetCycles();
+    for (uint32_t n = 0; n < iterations; n++) {
+        int32_t speed = (n & 1) ? 300 : -300;
+        Motor_SetSpeedPair(&bench[0], speed, &bench[1], speed, 1);
+    }
+    cycles_fast_flip = Perf_GetCycles() - start;
+
+    for (uint8_t i = 0; i < 2; i++) {
+        *bench[i].hw.ccr = ccr_saved[i];
+    }
+
+    // 每次迭代更新两个电机，折算为单电机耗时
+    float hal_same = (float)cycles_hal_same / (float)(iterations * 2U);
+    float fast_same = (float)cycles_fast_same / (float)(iterations * 2U);
+    float hal_flip = (float)cycles_hal_flip / (float)(iterations * 2U);
+    float fast_flip = (float)cycles_fast_flip / (float)(iterations * 2U);
+    my_printf(&huart2,"=== 电机输出耗时 (%lu次, 双电机, 单电机折算) ===\r\n", iterations);
+    my_printf(&huart2,"同向调速 HAL路径: %.1f cycles/次  寄存器直写: %.1f cycles/次 (%.2fx)\r\n",
+              hal_same, fast_same, fast_same > 0.0f ? hal_same / fast_same : 0.0f);
+    my_printf(&huart2,"每次换向 HAL路径: %.1f cycles/次  寄存器直写: %.1f cycles/次 (%.2fx)\r\n",
+              hal_flip, fast_flip, fast_flip > 0.0f ? hal_flip / fast_flip : 0.0f);
+}
+
 void motor_task(void) {
-    // 全局STBY控制：只有当全局enable为0时才关闭STBY
-    if (!enable) {
-        HAL_GPIO_WritePin(GPIOA, STBY_Pin, GPIO_PIN_RESET);  // 关闭整个TB6612
-    } else {
-        HAL_GPIO_WritePin(GPIOA, STBY_Pin, GPIO_PIN_SET);    // 开启整个TB6612
+    // 停车制动保持期间STBY保持开启，到时后转为滑行
+    uint8_t stop_brake = (motor_stop_brake_until != 0) &&
+                         ((int32_t)(HAL_GetTick() - motor_stop_brake_until) < 0);
+    if (!enable && !stop_brake && motor_stop_brake_until != 0) {
+        motor_stop_brake_until = 0;
+        Motor_SetMode(&motor1, MOTOR_MODE_COAST);
+        Motor_SetMode(&motor2, MOTOR_MODE_COAST);
     }
 
+    // 全局STBY控制：只有当全局enable为0时才关闭STBY (电平不变时不写)
+    Motor_WriteStby(GPIOA, STBY_Pin, enable || stop_brake);
+
+    // 部分制动：短路制动/滑行按1ms时隙调制
+    Motor_BrakeModulate(&motor1);
+    Motor_BrakeModulate(&motor2);
 }
 
 
@@ -171,6 +461,16 @@ void Motor_Start(void) {
     // 清零编码器数据，确保一致的启动条件
     clear_speed_data();
 
+    // 速度规划从静止起步，按加速度限制爬升到basic_speed
+    Profile_Reset(&speed_profile, 0.0f);
+
+    // 丢线恢复回到循线状态 (统计保留)
+    Recovery_Reset(&line_recovery);
+
+    // 停车期间偏差不更新，起步首拍不计算曲率增长率
+    speed_planner.line_valid = 0;
+
+    motor_stop_brake_until = 0;  // 取消停车制动，由pid_task接管输出
     enable = 1;  // 使能电机
 }
 
@@ -180,6 +480,14 @@ void Motor_Start(void) {
  */
 void Motor_StartStop(void) {
     enable = 0;  // 禁用电机
+
+    // 短路制动MOTOR_STOP_BRAKE_MS后再进入待机滑行，不再只靠摩擦停车
+    Motor_SetMode(&motor1, MOTOR_MODE_BRAKE);
+    Motor_SetMode(&motor2, MOTOR_MODE_BRAKE);
+    motor_stop_brake_until = HAL_GetTick() + MOTOR_STOP_BRAKE_MS;
+    if (motor_stop_brake_until == 0) {
+        motor_stop_brake_until = 1;  // 0表示无停车制动
+    }
 }
 
 /**
@@ -195,41 +503,19 @@ int8_t Motor_SetSpeedIndependent(Motor_t* motor, int32_t speed) {
     }
 
     // 检查速度范围
-    if (speed < -1000 || speed > 1000) {
+    if (speed < SPEED_MIN || speed > SPEED_MAX) {
         return -1;
     }
 
     // 确保TB6612芯片使能
-    HAL_GPIO_WritePin(motor->hw.stby_port, motor->hw.stby_pin, GPIO_PIN_SET);
+    Motor_WriteStby(motor->hw.stby_port, motor->hw.stby_pin, 1);
 
     // 更新电机状态
     motor->speed = speed;
+    motor->mode = MOTOR_MODE_DRIVE;
 
-    // 处理停止
-    if (speed == 0) {
-        // TB6612停止：IN1=0, IN2=0, PWM=0
-        HAL_GPIO_WritePin(motor->hw.in1_port, motor->hw.in1_pin, GPIO_PIN_RESET);
-        HAL_GPIO_WritePin(motor->hw.in2_port, motor->hw.in2_pin, GPIO_PIN_RESET);
-        __HAL_TIM_SET_COMPARE(motor->hw.htim, motor->hw.channel, 0);
-        motor->state = MOTOR_STATE_STOP;
-        return 0;
-    }
-
-    // 设置方向
-    if (speed > 0) {
-        HAL_GPIO_WritePin(motor->hw.in1_port, motor->hw.in1_pin, GPIO_PIN_RESET);
-        HAL_GPIO_WritePin(motor->hw.in2_port, motor->hw.in2_pin, GPIO_PIN_SET);
-        motor->state = MOTOR_STATE_FORWARD;
-    } else {
-        HAL_GPIO_WritePin(motor->hw.in1_port, motor->hw.in1_pin, GPIO_PIN_SET);
-        HAL_GPIO_WritePin(motor->hw.in2_port, motor->hw.in2_pin, GPIO_PIN_RESET);
-
-        motor->state = MOTOR_STATE_BACKWARD;
-    }
-
-    // 设置PWM占空比
-    uint16_t pwm_value = abs(speed);
-    __HAL_TIM_SET_COMPARE(motor->hw.htim, motor->hw.channel, pwm_value);
+    // 设置方向与PWM占空比
+    Motor_Output(motor, speed);
 
     return 0;
 }
@@ -9,12 +9,22 @@
 
 // 电机状态枚举
 typedef enum {
-    MOTOR_STATE_STOP = 0,     // 停止
+    MOTOR_STATE_STOP = 0,     // 停止 (IN1=IN2=0，TB6612输出高阻，滑行)
     MOTOR_STATE_FORWARD,      // 正转
     MOTOR_STATE_BACKWARD,     // 反转
+    MOTOR_STATE_BRAKE,        // 短路制动 (IN1=IN2=1)
     MOTOR_STATE_ERROR         // 错误
 } Motor_State_t;
 
+// 电机输出模式
+typedef enum {
+    MOTOR_MODE_DRIVE = 0,     // 驱动 (Motor_SetSpeed)
+    MOTOR_MODE_BRAKE,         // 制动 (满制动或按制动强度与滑行交替)
+    MOTOR_MODE_COAST          // 滑行
+} Motor_Mode_t;
+
+#define MOTOR_BRAKE_FULL      1000  // 满制动强度
+
 // 电机ID枚举
 typedef enum {
     MOTOR_ID_LEFT = 0,
@@ -31,6 +41,9 @@ typedef struct {
     uint16_t in2_pin;           // IN2控制引脚
     GPIO_TypeDef* stby_port;    // STBY使能端口
     uint16_t stby_pin;          // STBY使能引脚
+    volatile uint32_t* ccr;     // 比较寄存器地址 (Motor_Create中按通道计算，直接写CCR)
+    uint32_t in1_bsrr[MOTOR_STATE_ERROR]; // 各方向写入IN1端口的BSRR值 (按Motor_State_t索引，IN1/IN2同端口时含两引脚)
+    uint32_t in2_bsrr[MOTOR_STATE_ERROR]; // 各方向写入IN2端口的BSRR值 (同端口时为0，不写)
 } Motor_Hardware_t;
 
 // 电机实体结构体
@@ -38,8 +51,11 @@ typedef struct {
     Motor_ID_t motor_id;
     Motor_Hardware_t hw;      // 硬件配置
     int32_t speed;            // 当前速度 (-1000 到 +1000)
-    Motor_State_t state;      // 当前状态
+    Motor_State_t state;      // 当前状态 (同时作为方向引脚缓存，方向不变时不写GPIO)
     uint8_t enable;           // 使能标志
+    Motor_Mode_t mode;        // 输出模式
+    uint16_t brake_duty;      // 制动强度 (0~MOTOR_BRAKE_FULL)
+    uint16_t brake_acc;       // 制动Σ-Δ调制累加器
 } Motor_t;
 
 /**
@@ -60,6 +76,26 @@ int8_t Motor_Create(Motor_t* motor,
  */
 int8_t Motor_SetSpeed(Motor_t* motor, int32_t speed, uint8_t enable);
 
+/**
+ * @brief 双电机同步设置 - 两路比较值在同一次更新事件生效
+ */
+int8_t Motor_SetSpeedPair(Motor_t* left, int32_t left_speed, Motor_t* right, int32_t right_speed, uint8_t enable);
+
+/**
+ * @brief 设置电机输出模式 (驱动/满制动/滑行)
+ */
+int8_t Motor_SetMode(Motor_t* motor, Motor_Mode_t mode);
+
+/**
+ * @brief 部分制动 - 短路制动与滑行按1ms时隙交替，强度0~MOTOR_BRAKE_FULL
+ */
+int8_t Motor_Brake(Motor_t* motor, uint16_t strength);
+
+/**
+ * @brief 电机输出耗时基准测试 - 寄存器直写与HAL路径对比 (仅电机停止时)
+ */
+void Motor_Bench(uint32_t iterations);
+
 /**
  * @brief 电机停止函数
  */
@@ -0,0 +1,241 @@
+/**
+ * @file motor_shape.c
+ * @brief 电机输出整形模块实现 - 死区补偿、分段线性查找表与特性扫描标定
+ * @note 1. PWM = deadband + LUT(|effort|)，符号与效果值相同；|effort|低于MOTOR_SHAPE_ZERO_EFFORT时输出0
+ *       2. 标定后效果值与稳态轮速成正比：effort = 1000 对应full_speed，
+ *          full_speed取两轮满PWM轮速的较小值，同一效果值两轮轮速一致
+ *       3. 标定由满PWM向下扫描，得到的是车轮转动状态下的特性(动摩擦)，
+ *          死区取仍能保持转动的最低PWM，与速度环运行时的工况一致
+ */
+#include "motor_shape.h"
+
+#define SHAPE_EFFORT_STEP     ((float)MOTOR_SHAPE_PWM_MAX / (float)(MOTOR_SHAPE_POINTS - 1))
+
+Motor_Shape_t motor_shape;
+
+/**
+ * @brief 电机输出整形初始化函数
+ * @param shape 整形数据指针
+ */
+void Shape_Init(Motor_Shape_t* shape) {
+    if (shape == NULL) return;
+
+    memset(shape, 0, sizeof(Motor_Shape_t));
+    Shape_ResetTables(shape);
+    shape->enabled = MOTOR_SHAPE_ENABLE;
+}
+
+/**
+ * @brief 恢复恒等映射
+ * @param shape 整形数据指针
+ */
+void Shape_ResetTables(Motor_Shape_t* shape) {
+    if (shape == NULL) return;
+
+    for (uint8_t m = 0; m < MOTOR_SHAPE_MOTOR_NUM; m++) {
+        shape->table[m].deadband = 0;
+        for (uint8_t i = 0; i < MOTOR_SHAPE_POINTS; i++) {
+            shape->table[m].pwm[i] = (int16_t)(SHAPE_EFFORT_STEP * (float)i + 0.5f);
+        }
+    }
+    shape->full_speed = 0.0f;
+}
+
+/**
+ * @brief 设置死区补偿PWM (查找表不变，满量程超出部分由Shape_Apply限幅)
+ * @param shape 整形数据指针
+ * @param id 电机ID (Motor_ID_t)
+ * @param deadband 死区补偿PWM (0~MOTOR_SHAPE_PWM_MAX)
+ */
+void Shape_SetDeadband(Motor_Shape_t* shape, uint8_t id, int16_t deadband) {
+    if (shape == NULL || id >= MOTOR_SHAPE_MOTOR_NUM) return;
+
+    if (deadband < 0) deadband = 0;
+    if (deadband > MOTOR_SHAPE_PWM_MAX) deadband = MOTOR_SHAPE_PWM_MAX;
+    shape->table[id].deadband = deadband;
+}
+
+/**
+ * @brief 效果值 -> PWM
+ * @param shape 整形数据指针
+ * @param id 电机ID (Motor_ID_t)
+ * @param effort 速度环输出 (-1000 ~ +1000)
+ * @return PWM (-1000 ~ +1000)
+ */
+int32_t Shape_Apply(const Motor_Shape_t* shape, uint8_t id, float effort) {
+    float mag = fabsf(effort);
+
+    if (!shape->enabled) {
+        if (mag > MOTOR_SHAPE_PWM_MAX) mag = MOTOR_SHAPE_PWM_MAX;
+        return (int32_t)(effort < 0.0f ? -mag : mag);
+    }
+    if (mag < MOTOR_SHAPE_ZERO_EFFORT) {
+        return 0;  // 零点附近不补偿死区，避免PID输出噪声在±deadband之间跳变
+    }
+    if (mag > MOTOR_SHAPE_PWM_MAX) mag = MOTOR_SHAPE_PWM_MAX;
+
+    const Shape_Table_t *t = &shape->table[id];
+    float pos = mag / SHAPE_EFFORT_STEP;
+    uint8_t i = (uint8_t)pos;
+    if (i >= MOTOR_SHAPE_POINTS - 1) i = MOTOR_SHAPE_POINTS - 2;
+    float frac = pos - (float)i;
+
+    float pwm = (float)t->deadband + (float)t->pwm[i] + (float)(t->pwm[i + 1] - t->pwm[i]) * frac;
+    if (pwm > MOTOR_SHAPE_PWM_MAX) pwm = MOTOR_SHAPE_PWM_MAX;
+
+    return (int32_t)(effort < 0.0f ? -pwm : pwm);
+}
+
+/**
+ * @brief 开始特性标定 (车轮需架空，两电机同时由满PWM向下扫描)
+ * @param shape 整形数据指针
+ * @param now_ms 当前时间(ms)
+ */
+void Shape_StartCharacterize(Motor_Shape_t* shape, uint32_t now_ms) {
+    if (shape == NULL) return;
+
+    memset(shape->char_speed, 0, sizeof(shape->char_speed));
+    shape->char_sum[0] = shape->char_sum[1] = 0.0f;
+    shape->char_samples = 0;
+    shape->char_step = 0;
+    shape->char_step_tick = now_ms;
+    shape->char_state = SHAPE_CHAR_RUNNING;
+}
+
+/**
+ * @brief 中止特性标定 (查找表不变)
+ * @param shape 整形数据指针
+ */
+void Shape_StopCharacterize(Motor_Shape_t* shape) {
+    if (shape == NULL || shape->char_state != SHAPE_CHAR_RUNNING) return;
+
+    shape->char_state = SHAPE_CHAR_ABORTED;
+}
+
+/**
+ * @brief 在升序PWM-轮速曲线上反查达到目标轮速所需的PWM
+ * @param speed 单调化后的轮速曲线
+ * @param target 目标轮速(m/s)
+ * @return PWM
+ */
+static float Shape_InversePwm(const float *speed, float target) {
+    for (uint16_t j = 1; j < MOTOR_CHAR_STEPS; j++) {
+        if (speed[j] >= target) {
+            float dv = speed[j] - speed[j - 1];
+            float frac = (dv > 0.0f) ? (target - speed[j - 1]) / dv : 1.0f;
+            return (float)((j - 1) * MOTOR_CHAR_PWM_STEP) + frac * (float)MOTOR_CHAR_PWM_STEP;
+        }
+    }
+    return (float)MOTOR_SHAPE_PWM_MAX;
+}
+
+/**
+ * @brief 由扫描结果生成死区和查找表
+ * @param shape 整形数据指针
+ * @return 1-成功，0-失败 (查找表不变)
+ */
+static uint8_t Shape_BuildTables(Motor_Shape_t* shape) {
+    uint16_t breakaway[MOTOR_SHAPE_MOTOR_NUM];
+    float full_speed = 0.0f;
+
+    for (uint8_t m = 0; m < MOTOR_SHAPE_MOTOR_NUM; m++) {
+        float *speed = shape->char_speed[m];
+
+        // 单调化：测量噪声不应让反查出现PWM回退
+        for (uint16_t j = 1; j < MOTOR_CHAR_STEPS; j++) {
+            if (speed[j] < speed[j - 1]) speed[j] = speed[j - 1];
+        }
+        if (speed[MOTOR_CHAR_STEPS - 1] < MOTOR_CHAR_MIN_FULL_SPEED) {
+            return 0;
+        }
+
+        breakaway[m] = MOTOR_CHAR_STEPS - 1;
+        for (uint16_t j = 0; j < MOTOR_CHAR_STEPS; j++) {
+            if (speed[j] >= MOTOR_CHAR_MOVE_SPEED) {
+                breakaway[m] = j;
+                break;
+            }
+        }
+
+        if (m == 0 || speed[MOTOR_CHAR_STEPS - 1] < full_speed) {
+            full_speed = speed[MOTOR_CHAR_STEPS - 1];
+        }
+    }
+
+    for (uint8_t m = 0; m < MOTOR_SHAPE_MOTOR_NUM; m++) {
+        Shape_Table_t *t = &shape->table[m];
+        t->deadband = (int16_t)(breakaway[m] * MOTOR_CHAR_PWM_STEP);
+        t->pwm[0] = 0;
+        for (uint8_t i = 1; i < MOTOR_SHAPE_POINTS; i++) {
+            float target = full_speed * (float)i / (float)(MOTOR_SHAPE_POINTS - 1);
+            float pwm = Shape_InversePwm(shape->char_speed[m], target) - (float)t->deadband;
+            if (pwm < (float)t->pwm[i - 1]) pwm = (float)t->pwm[i - 1];
+            t->pwm[i] = (int16_t)(pwm + 0.5f);
+        }
+    }
+    shape->full_speed = full_speed;
+    return 1;
+}
+
+/**
+ * @brief 特性标定周期更新函数 (pid_task中调用)
+ * 每步先等待轮速稳定，再在MOTOR_CHAR_MEASURE_MS内平均编码器轮速；扫描结束后生成查找表
+ * @param shape 整形数据指针
+ * @param v_left 左轮速度(m/s)
+ * @param v_right 右轮速度(m/s)
+ * @param now_ms 当前时间(ms)
+ * @return 本周期两电机应输出的PWM (标定结束后为0)
+ */
+int32_t Shape_CharUpdate(Motor_Shape_t* shape, float v_left, float v_right, uint32_t now_ms) {
+    if (shape == NULL || shape->char_state != SHAPE_CHAR_RUNNING) return 0;
+
+    uint32_t elapsed = now_ms - shape->char_step_tick;
+    uint32_t settle = (shape->char_step == 0) ? MOTOR_CHAR_SPINUP_MS : MOTOR_CHAR_SETTLE_MS;
+
+    if (elapsed >= settle) {
+        shape->char_sum[MOTOR_ID_LEFT] += v_left;
+        shape->char_sum[MOTOR_ID_RIGHT] += v_right;
+        shape->char_samples++;
+    }
+
+    if (elapsed >= settle + MOTOR_CHAR_MEASURE_MS) {
+        uint16_t idx = MOTOR_CHAR_STEPS - 1 - shape->char_step;
+        for (uint8_t m = 0; m < MOTOR_SHAPE_MOTOR_NUM; m++) {
+            shape->char_speed[m][idx] = (shape->char_samples > 0) ? shape->char_sum[m] / (float)shape->char_samples : 0.0f;
+            shape->char_sum[m] = 0.0f;
+        }
+        shape->char_samples = 0;
+        shape->char_step++;
+        shape->char_step_tick = now_ms;
+
+        if (shape->char_step >= MOTOR_CHAR_STEPS) {
+            shape->char_state = Shape_BuildTables(shape) ? SHAPE_CHAR_DONE : SHAPE_CHAR_FAILED;
+            return 0;
+        }
+    }
+
+    return MOTOR_SHAPE_PWM_MAX - (int32_t)shape->char_step * MOTOR_CHAR_PWM_STEP;
+}
+
+/**
+ * @brief 是否正在标定
+ */
+uint8_t Shape_IsCharacterizing(const Motor_Shape_t* shape) {
+    return shape->char_state == SHAPE_CHAR_RUNNING;
+}
+
+/**
+ * @brief 获取标定状态名称
+ * @param state 标定状态
+ * @return 状态名称字符串
+ */
+const char* Shape_GetCharStateName(Shape_CharState_t state) {
+    switch (state) {
+        case SHAPE_CHAR_NONE:    return "未标定";
+        case SHAPE_CHAR_RUNNING: return "扫描中";
+        case SHAPE_CHAR_DONE:    return "完成";
+        case SHAPE_CHAR_FAILED:  return "失败";
+        case SHAPE_CHAR_ABORTED: return "已中止";
+        default:                 return "未知";
+    }
+}
@@ -0,0 +1,87 @@
+/**
+ * @file motor_shape.h
+ * @brief 电机输出整形模块头文件 - 速度环输出(效果值)经死区补偿和分段线性表映射为PWM，含特性自动标定
+ */
+#ifndef MOTOR_SHAPE_H
+#define MOTOR_SHAPE_H
+
+#include "mydefine.h"
+
+// 电机输出整形配置参数已迁移到mydefine.h统一管理
+
+#define MOTOR_SHAPE_MOTOR_NUM     2    // 按Motor_ID_t索引 (左/右)
+#define MOTOR_CHAR_STEPS          (MOTOR_SHAPE_PWM_MAX / MOTOR_CHAR_PWM_STEP + 1) // 扫描点数 (含PWM=0)
+
+// 特性标定状态
+typedef enum {
+    SHAPE_CHAR_NONE = 0,       // 未标定 (使用默认/手动参数)
+    SHAPE_CHAR_RUNNING,        // 扫描中
+    SHAPE_CHAR_DONE,           // 标定完成，查找表已更新
+    SHAPE_CHAR_FAILED,         // 标定失败 (满PWM轮速过低，查找表未改变)
+    SHAPE_CHAR_ABORTED         // 被stop中止
+} Shape_CharState_t;
+
+// 单个电机的整形参数
+typedef struct {
+    int16_t deadband;                  // 死区补偿PWM (车轮刚好保持转动的PWM)
+    int16_t pwm[MOTOR_SHAPE_POINTS];   // 效果值点i对应的死区之上PWM，效果点均匀分布在0~MOTOR_SHAPE_PWM_MAX
+} Shape_Table_t;
+
+// 电机输出整形数据结构
+typedef struct {
+    uint8_t enabled;                           // 整形使能 (0: 效果值直接作为PWM)
+    Shape_Table_t table[MOTOR_SHAPE_MOTOR_NUM];// 各电机整形参数
+    float full_speed;                          // 效果值满量程对应轮速(m/s)，标定后有效
+
+    Shape_CharState_t char_state;              // 特性标定状态
+    uint16_t char_step;                        // 当前扫描步 (0为满PWM，向下扫描)
+    uint32_t char_step_tick;                   // 当前步开始时间(ms)
+    float char_sum[MOTOR_SHAPE_MOTOR_NUM];     // 当前步轮速累加
+    uint16_t char_samples;                     // 当前步样本数
+    float char_speed[MOTOR_SHAPE_MOTOR_NUM][MOTOR_CHAR_STEPS]; // 各步稳态轮速(m/s)，按PWM升序存放
+} Motor_Shape_t;
+
+extern Motor_Shape_t motor_shape; // 全局电机输出整形
+
+/**
+ * @brief 电机输出整形初始化函数 (恒等映射)
+ */
+void Shape_Init(Motor_Shape_t* shape);
+
+/**
+ * @brief 恢复恒等映射 (死区0，效果值即PWM)
+ */
+void Shape_ResetTables(Motor_Shape_t* shape);
+
+/**
+ * @brief 设置死区补偿PWM
+ */
+void Shape_SetDeadband(Motor_Shape_t* shape, uint8_t id, int16_t deadband);
+
+/**
+ * @brief 效果值 -> PWM (符号保留)
+ */
+int32_t Shape_Apply(const Motor_Shape_t* shape, uint8_t id, float effort);
+
+/**
+ * @brief 开始/停止特性标定
+ */
+void Shape_StartCharacterize(Motor_Shape_t* shape, uint32_t now_ms);
+void Shape_StopCharacterize(Motor_Shape_t* shape);
+
+/**
+ * @brief 特性标定周期更新函数 - 返回本周期两电机应输出的PWM
+ */
+int32_t Shape_CharUpdate(Motor_Shape_t* shape, float v_left, float v_right, uint32_t now_ms);
+
+/**
+ * @brief 是否正在标定
+ */
+uint8_t Shape_IsCharacterizing(const Motor_Shape_t* shape);
+
+/**
+ * @brief 获取标定状态名称
+ */
+const char* Shape_GetCharStateName(Shape_CharState_t state);
+
+#endif
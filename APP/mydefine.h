@@ -3,7 +3,8 @@
  * @brief 全局头文件定义 - 统一包含所有系统头文件和应用模块
  */
 
-// STM32 HAL库头文件
+// STM32 HAL库头文件 (定义HOST_BUILD时为主机端测试工程tests/，不包含硬件相关头文件)
+#ifndef HOST_BUILD
 #include "adc.h"
 #include "dma.h"
 #include "gpio.h"
@@ -11,6 +12,7 @@
 #include "main.h"
 #include "tim.h"
 #include "usart.h"
+#endif
 
 // 标准C库头文件
 #include "math.h"
@@ -21,25 +23,51 @@
 #include "string.h"
 
 // 应用模块头文件
+#ifndef HOST_BUILD
 #include "adc_app.h"
 #include "encoder_app.h"
 #include "JY901S_app.h"
+#include "heading_app.h"
+#include "yaw_fusion.h"
+#include "imu_stream.h"
 #include "motor_app.h"
+#include "motor_shape.h"
 #include "oled_app.h"
 #include "scheduler.h"
 #include "usart_app.h"
 #include "gary_app.h"
+#include "line_classifier.h"
+#include "gary_threshold.h"
 #include "pid_control.h"
+#include "motion_profile.h"
+#include "line_recovery.h"
+#include "speed_planner.h"
+#include "track_map.h"
+#include "perf_counter.h"
+#include "sample_align.h"
+#include "control_bench.h"
+#include "flash_app.h"
+#else
+// 主机端只编译与硬件无关的模块
+#include "gary_app.h"
+#include "line_classifier.h"
+#include "pid_control.h"
+#include "motion_profile.h"
+#include "control_bench.h"
+#endif
 
 // 第三方组件头文件
+#ifndef HOST_BUILD
 #include "ssd1306.h"
 #include "ssd1306_conf_template.h"
 #include "ssd1306_fonts.h"
 
 #include "gw_grayscale_sensor.h"
 #include "hardware_iic.h"
+#endif
 
 #include "pid.h"
+#include "pid_bank.h"
 
 // ==================== 编码器系统配置区块 ====================
 // 编码器基础参数
@@ -71,7 +99,7 @@
 // ==================== Gary灰度传感器配置区块 ====================
 // Gary传感器基础参数 (使用I2C3接口)
 #define GARY_I2C_ADDR         0x4C         // 感为8通道灰度传感器I2C地址
-#define GARY_SAMPLE_TIME      30           // 采样时间间隔(ms)
+#define GARY_SAMPLE_TIME      1            // 采样时间间隔(ms)，DMA单次事务读取，1kHz
 #define GARY_COMM_TIMEOUT     100          // I2C通信超时时间(ms)
 #define GARY_MAX_RETRY        3            // 最大重试次数
 #define GARY_FILTER_SIZE      3            // 滤波窗口大小
@@ -87,18 +115,194 @@
 #define GARY_CENTER_CHANNELS  0x18         // 中央通道掩码 (00011000)
 #define GARY_ALL_CHANNELS     0xFF         // 全通道掩码
 
-// 循线位置权重数组 (用于位置偏差计算)
-#define GARY_LINE_WEIGHTS     {4.0f, 3.0f, 2.0f, 1.0f, -1.0f, -2.0f, -3.0f, -4.0f}  // 8通道位置权重
+// 循线位置权重 (用于位置偏差计算，单通道宏供编译期模式表展开)
+#define GARY_WEIGHT_0         4.0f
+#define GARY_WEIGHT_1         3.0f
+#define GARY_WEIGHT_2         2.0f
+#define GARY_WEIGHT_3         1.0f
+#define GARY_WEIGHT_4         -1.0f
+#define GARY_WEIGHT_5         -2.0f
+#define GARY_WEIGHT_6         -3.0f
+#define GARY_WEIGHT_7         -4.0f
+#define GARY_LINE_WEIGHTS     {GARY_WEIGHT_0, GARY_WEIGHT_1, GARY_WEIGHT_2, GARY_WEIGHT_3, \
+                               GARY_WEIGHT_4, GARY_WEIGHT_5, GARY_WEIGHT_6, GARY_WEIGHT_7}  // 8通道位置权重
 
 // PID控制接口参数 (基于平均值算法，范围±4.0)
 #define GARY_ERROR_MAX        4.0f         // 最大偏差值
 #define GARY_ERROR_MIN        -4.0f        // 最小偏差值
 
+// 传感器安装几何 (偏差换算横向偏移)
+#define GARY_SENSOR_PITCH_M       0.012f   // 灰度传感器通道间距(m)，偏差1.0对应一个通道
+#define GARY_SENSOR_LOOKAHEAD_M   0.10f    // 灰度传感器到驱动轴距离(m)
+
 // 循线状态判定阈值参数 (基于平均值算法{-4.0,-3.0,-2.0,-1.0,1.0,2.0,3.0,4.0}优化)
 #define GARY_CENTER_THRESHOLD     0.5f     // 中央状态阈值 (±0.5)
 #define GARY_SLIGHT_THRESHOLD     1.5f     // 轻微偏移阈值 (0.5-1.5)
 #define GARY_MODERATE_THRESHOLD   2.5f     // 中度偏移阈值 (1.5-2.5)
 #define GARY_SHARP_THRESHOLD      3.5f     // 急剧偏移阈值 (>2.5)
 
+// 模拟量质心定位参数 (标定后由模拟数据计算连续偏差)
+#define GARY_CAL_WHITE_DEFAULT    220          // 白场原始值默认标定 (未标定时使用)
+#define GARY_CAL_BLACK_DEFAULT    30           // 黑场原始值默认标定 (未标定时使用)
+#define GARY_CAL_MIN_SPAN         20           // 单通道黑白差最小值，低于此值该通道不参与定位
+#define GARY_CONTRAST_MIN         0.35f        // 最小对比度(归一化黑度最大-最小)，低于此值回退数字算法
+#define GARY_CENTROID_WINDOW      1            // 质心窗口半宽(通道数)，以黑度峰值通道为中心
+#define GARY_CAL_MAGIC            0x4C414347U  // 标定数据Flash记录魔数 ("GCAL")
+
+// 自适应阈值 (每通道在线两均值聚类，跟踪场地光照)
+#define GARY_ADAPT_ENABLE         1            // 上电默认使能
+#define GARY_ADAPT_RATE           0.002f       // 类均值每帧更新速率 (1kHz下时间常数约0.5s)
+#define GARY_ADAPT_MAX_DRIFT      60.0f        // 类均值相对标定值最大漂移(原始值)
+#define GARY_ADAPT_LUT_PERIOD_MS  200          // 查找表跟随检查周期(ms)
+#define GARY_ADAPT_LUT_STEP       4            // 端点变化达到此值(原始值)才重建该通道查找表
+
+// 自适应采集 (位图简单时只读1字节数字寄存器，边缘/歧义/过渡时读8字节模拟量)
+#define GARY_ACQ_ADAPTIVE         1            // 上电默认使能
+#define GARY_ACQ_CENTER_MASK      0x3C         // 简单位图的黑线须落在通道2-5内 (00111100)
+#define GARY_ACQ_MAX_WIDTH        3            // 简单位图最大线宽(通道数)
+#define GARY_ACQ_CALM_FRAMES      5            // 连续简单模拟帧数达到此值才降级为数字读取
+#define GARY_ACQ_REFRESH          10           // 连续数字读取达到此值强制读一次模拟量(刷新质心/阈值跟踪)
+#define GARY_I2C_BIT_US           2.5f         // I2C3位时间(us)，400kHz，用于估算总线占用
+
+// 循线状态时域分类参数 (按采样帧计数，1kHz采样时1帧=1ms)
+#define GARY_STATE_HYST           0.2f         // 偏移档位切换滞回量(偏差单位)
+#define LINE_CLASS_WINDOW         8            // 状态证据分数上限(帧)
+#define LINE_CLASS_ENTER          5            // 候选状态分数达到此值才可切换
+#define LINE_CLASS_EXIT           3            // 稳定状态分数降到此值以下才可切换
+#define LINE_CLASS_MIN_DWELL      5            // 稳定状态最小保持帧数
+
+// ==================== IMU航向配置区块 ====================
+// IMU传输方式: I2C2轮询读取 或 USART1主动输出流 (模块串口波特率需与IMU_UART_BAUD一致)
+#define IMU_TRANSPORT_I2C         0
+#define IMU_TRANSPORT_UART        1
+#define IMU_TRANSPORT             IMU_TRANSPORT_I2C
+#define IMU_UART_BAUD             115200   // USART1波特率，200Hz×33字节/样本需≥66000bps
+#define IMU_STREAM_BUF_SIZE       512      // USART1循环DMA缓冲区(字节，2的幂)
+
+// IMU配置档 (启动时回读，与模块当前配置不同才写入并保存)
+#if IMU_TRANSPORT == IMU_TRANSPORT_UART
+#define IMU_CFG_RATE              RRATE_200HZ  // 输出速率，串口流按200Hz输出
+#else
+#define IMU_CFG_RATE              RRATE_100HZ  // 输出速率，与imu_task 10ms轮询一致
+#endif
+#define IMU_CFG_BANDWIDTH         BANDWIDTH_94HZ // 滤波带宽，越高滤波延迟越小 (94Hz约3ms)
+#define IMU_CFG_CONTENT           (RSW_ACC | RSW_GYRO | RSW_ANGLE) // 输出内容
+#define IMU_CFG_AXIS6             ALGRITHM6    // 6轴算法(不使用磁力计)
+#define IMU_CFG_WRITE_DELAY_MS    20       // 每次寄存器写入后等待(ms)
+#define IMU_CFG_SAVE_DELAY_MS     100      // 保存到模块FLASH后等待(ms)
+
+#define HEADING_STILL_SPEED       0.01f    // 静止判定轮速(m/s)，左右轮均低于此值
+#define HEADING_STILL_SETTLE_MS   200      // 停车后等待时间(ms)，之后才估计零偏
+#define HEADING_BIAS_RATE         0.02f    // 零偏/漂移率每样本更新速率 (10ms采样下时间常数约0.5s)
+#define HEADING_BIAS_MAX          2.0f     // 零偏/漂移率估计上限(°/s)
+#define HEADING_SAMPLE_GAP_MS     100      // 相邻IMU样本最大间隔(ms)，超过时不累加偏航角变化
+
+// 角速度融合 (陀螺仪高通 + 编码器轮速差低通)
+#define FUSION_CROSSOVER_HZ       1.0f     // 交叉频率(Hz)，低于此频率信编码器，高于此频率信陀螺仪
+#define FUSION_CROSSOVER_MIN_HZ   0.05f    // 交叉频率可调下限(Hz)
+#define FUSION_CROSSOVER_MAX_HZ   10.0f    // 交叉频率可调上限(Hz)
+#define FUSION_SLIP_RATE          0.5f     // 打滑门限：编码器与陀螺仪角速度差(rad/s)
+#define FUSION_SLIP_HOLD_MS       200      // 打滑后只用陀螺仪的保持时间(ms)
+
+// ==================== 采样时间对齐配置区块 ====================
+#define SAMPLE_ALIGN_ENABLE       1        // 控制器按控制时刻对齐航向、轮速和循线偏差 (0: 直接用最新样本)
+#define SAMPLE_MAX_EXTRAP_US      20000    // 最大外推时长(us)，样本停更时不继续外推
+
+// ==================== 运动控制配置区块 ====================
+// 车体速度控制 (v, ω) -> 左右轮目标速度 (逆运动学基于WHEEL_BASE)
+#define BODY_WHEEL_SPEED_MAX      2.0f     // 单轮目标速度上限(m/s)，与speed指令范围一致
+#define BODY_OMEGA_MAX            (2.0f * BODY_WHEEL_SPEED_MAX / WHEEL_BASE) // 原地转向时的最大角速度(rad/s)
+#define PID_CONTROL_PERIOD_S      0.01f    // pid_task控制周期(s)，与scheduler中pid_task周期一致
+
+// 速度规划 (speed/start指令 -> S曲线过渡 -> 车体速度控制)
+#define PROFILE_MAX_ACCEL         3.0f     // 最大线加速度(m/s²)，按轮胎附着上限整定
+#define PROFILE_MAX_JERK          30.0f    // 最大加加速度(m/s³)，决定加速度建立时间 A/J
+#define PROFILE_MAX_DECEL         4.0f     // 最大减速度(m/s²)，短路制动可用，受轮胎附着限制，按实测整定
+
+// 减速控制 (超速较多时短路制动代替反向驱动，stop时先制动再待机)
+#define DECEL_BRAKE_ENABLE        1        // 上电时启用减速制动
+#define DECEL_BRAKE_ENTER         0.15f    // 进入制动的超速量(m/s)
+#define DECEL_BRAKE_EXIT          0.03f    // 退出制动的超速量(m/s)
+#define DECEL_BRAKE_FULL_ERR      0.5f     // 超速量达到此值时满制动(m/s)，之间按比例调制
+#define MOTOR_STOP_BRAKE_MS       300      // stop后短路制动保持时间(ms)，之后STBY关闭滑行
+
+// 丢线恢复 (丢线 -> 向最后偏差一侧转向 -> 超时旋转/螺旋搜索)
+#define LINE_LOST_CONFIRM_MS      20       // 丢线确认时间(ms)，期间保持最后角速度
+#define LINE_RECOVER_STEER_MS     400      // 转向找线最长时间(ms)，超时进入搜索
+#define LINE_RECOVER_SPEED_SCALE  0.5f     // 转向找线时线速度比例
+#define LINE_RECOVER_OMEGA        2.67f    // 转向找线最小角速度(rad/s)，与循线环输出上限一致
+#define LINE_RECOVER_ERROR_MIN    0.5f     // 判断丢线方向的最小偏差，低于此值参考最后角速度
+#define LINE_RECOVER_OMEGA_MIN    0.2f     // 判断丢线方向的最小角速度(rad/s)
+#define LINE_SEARCH_OMEGA         3.0f     // 搜索角速度(rad/s)
+#define LINE_SEARCH_SPEED         0.0f     // 搜索结束时线速度(m/s)，0为原地旋转，>0为螺旋
+#define LINE_SEARCH_TIMEOUT_MS    3000     // 搜索超时(ms)，超时停车
+
+// 曲率自适应速度规划 (曲率估计 -> v=sqrt(a_lat/κ) -> 速度规划)
+#define PLANNER_LAT_ACCEL         2.0f     // 横向加速度限制(m/s²)
+#define PLANNER_V_MAX             1.0f     // 直道最高速度(m/s)
+#define PLANNER_V_MIN             0.2f     // 弯道最低速度(m/s)
+#define PLANNER_V_EST_MIN         0.1f     // 车体曲率估计最低车速(m/s)，低于此值ω/v不可靠
+#define PLANNER_RATE_TAU_S        0.03f    // 偏差变化率低通时间常数(s)
+#define PLANNER_LOOKAHEAD_S       0.15f    // 曲率增长前瞻时间(s)，提前减速
+#define PLANNER_KAPPA_RELEASE_S   0.30f    // 曲率下降释放时间常数(s)，出弯后平滑提速
+
+// 赛道学习 (首圈按里程记录曲率/路口 -> 后续圈定位并按速度曲线行驶)
+#define TRACK_BIN_M               0.05f    // 地图格长度(m)
+#define TRACK_MAX_BINS            400      // 地图最大格数 (最长圈长20m)
+#define TRACK_KAPPA_SCALE         16.0f    // 曲率量化比例 (uint8存储，最大约16/m)
+#define TRACK_MIN_LAP_M           2.0f     // 闭环判定最短圈长(m)
+#define TRACK_LAP_YAW_TOL_DEG     30.0f    // 闭环判定航向容差(度)，IMU未就绪时不检查
+#define TRACK_LOC_WINDOW_M        0.30f    // 事件定位吸附窗口(m)，超出时只靠里程
+#define TRACK_PREVIEW_M           0.10f    // 速度曲线前瞻距离(m)
+#define TRACK_ACCEL_MARGIN        0.8f     // 速度曲线纵向加/减速度取速度规划限制的比例
+#define TRACK_MAGIC               0x50414D54U  // 赛道地图Flash记录魔数 ("TMAP")
+
+// ==================== 电池电压补偿配置区块 ====================
+// PWM输出 × VBAT_NOMINAL/Vbat，控制参数与查找表按VBAT_NOMINAL整定，电池放电过程中输出轮速不变
+// 分压比未实测前补偿和降额都会按错误电压工作，默认关闭；battery cal <V>标定后用battery on开启
+#define VBAT_COMP_ENABLE          0        // 上电时启用电压补偿和低压降额
+#define VBAT_DIVIDER_RATIO        4.0f     // 默认分压比 (R1+R2)/R2，电池电压 = ADC引脚电压 × 此值，按实际电阻修改
+#define VBAT_CAL_PIN_MIN          0.1f     // 标定时ADC引脚电压下限(V)，低于此值认为分压电路未接
+#define VBAT_NOMINAL              7.4f     // 控制参数整定时的电池电压(V) (2S锂电标称)
+#define VBAT_SAMPLE_PERIOD_S      0.05f    // adc_task周期(s)，与scheduler中adc_task周期一致
+#define VBAT_FILTER_TAU_S         2.0f     // 电池电压低通时间常数(s)
+#define VBAT_COMP_MIN             0.8f     // 补偿系数下限 (满电/充电器供电时)
+#define VBAT_COMP_MAX             1.3f     // 补偿系数上限 (VBAT_NOMINAL/1.3约5.7V以下不再增加)
+#define VBAT_VALID_MIN            3.0f     // 低于此值视为未接电池(仅USB供电)，不补偿
+#define VBAT_DERATE_START         6.8f     // 开始降额电压(V) (3.4V/节)
+#define VBAT_DERATE_END           6.4f     // 降额到最小的电压(V) (3.2V/节)
+#define VBAT_DERATE_MIN           0.5f     // 最低降额系数
+
+// ==================== 电机输出整形配置区块 ====================
+// 速度环输出(效果值) -> 死区补偿 + 分段线性表 -> PWM (默认表为恒等映射，标定前不改变输出)
+#define MOTOR_SHAPE_ENABLE        1        // 上电时启用输出整形
+#define MOTOR_SHAPE_POINTS        11       // 查找表点数，效果值0~MOTOR_SHAPE_PWM_MAX均匀分布
+#define MOTOR_SHAPE_PWM_MAX       1000     // 效果值/PWM满量程，与Motor_SetSpeed范围一致
+#define MOTOR_SHAPE_ZERO_EFFORT   5.0f     // 效果值绝对值低于此值输出0，不做死区补偿
+
+// 特性标定 (motor characterize，车轮需架空，约22s)
+#define MOTOR_CHAR_PWM_STEP       25       // 扫描PWM步长，由满量程向下扫描到0
+#define MOTOR_CHAR_SPINUP_MS      1000     // 首点(满PWM)起转等待时间(ms)
+#define MOTOR_CHAR_SETTLE_MS      300      // 每步稳定等待时间(ms)，需大于编码器低速采样周期
+#define MOTOR_CHAR_MEASURE_MS     200      // 每步轮速平均时间(ms)
+#define MOTOR_CHAR_MOVE_SPEED     0.02f    // 判定车轮仍在转动的最低轮速(m/s)
+#define MOTOR_CHAR_MIN_FULL_SPEED 0.2f     // 满PWM最低轮速(m/s)，低于此值判定标定失败
 
+// ==================== 闭环基准测试配置区块 ====================
+// 仿真对象：直流电机一阶模型 + 差速底盘 (用于bench指令离线对比控制参数)
+#define BENCH_SIM_DT              0.001f   // 对象积分步长(s)
+#define BENCH_WHEEL_V_MAX         2.6f     // PWM=999时的稳态轮速(m/s)，由35%PWM约6RPS折算
+#define BENCH_WHEEL_TAU           0.08f    // 电机+车体机械时间常数(s)
+#define BENCH_WHEEL_DEADBAND      0.03f    // 静摩擦死区(折算为稳态轮速，m/s)
+#define BENCH_SENSOR_LOOKAHEAD    GARY_SENSOR_LOOKAHEAD_M  // 灰度传感器到驱动轴距离(m)
+#define BENCH_SENSOR_PITCH        GARY_SENSOR_PITCH_M      // 灰度传感器通道间距(m)
+#define BENCH_SETTLE_BAND         0.02f    // 调节时间判定带(相对阶跃幅值)
 
+// ==================== Flash参数存储配置区块 ====================
+// 扇区6/7(各128KB)分别保存赛道地图和标定数据，已从链接脚本FLASH区域中排除
+#define FLASH_TRACK_ADDR          0x08040000U       // 赛道地图扇区起始地址
+#define FLASH_TRACK_SECTOR        FLASH_SECTOR_6    // 赛道地图扇区编号
+#define FLASH_TRACK_SIZE          (128U * 1024U)    // 赛道地图扇区大小(字节)
+#define FLASH_CALIB_ADDR          0x08060000U       // 标定数据扇区起始地址
+#define FLASH_CALIB_SECTOR        FLASH_SECTOR_7    // 标定数据扇区编号
+#define FLASH_CALIB_SIZE          (128U * 1024U)    // 标定数据扇区大小(字节)
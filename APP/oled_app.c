@@ -55,8 +55,8 @@ void oled_task(void)
             // 第二行：显示右轮（编码器B）线速度
             Oled_Printf_H(5,20,"R: %.2fm/s  ",encoder_data_B.speed_m_s);
 
-            // 第三行：显示ADC电压
-            Oled_Printf_H(5,30,"V:%.2fV  ",voltage);
+            // 第三行：显示电池电压和电压补偿系数
+            Oled_Printf_H(5,30,"B:%.2fV k%.2f  ",battery.vbat_filtered,battery.factor);
 
             // 第四行：显示Gary传感器8通道状态
 
@@ -0,0 +1,55 @@
+/**
+ * @file perf_counter.c
+ * @brief 性能计数模块实现 - 基于DWT周期计数器的代码耗时测量
+ */
+#include "perf_counter.h"
+
+static uint32_t perf_last_cycles = 0;   // 上次读取时的周期计数
+static uint32_t perf_cycle_rem = 0;     // 不足1us的剩余周期
+static uint32_t perf_micros = 0;        // 累计微秒
+
+/**
+ * @brief  性能计数器初始化函数
+ * @retval None
+ */
+void Perf_Init(void) {
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk; // 使能DWT/ITM跟踪模块
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;            // 启动周期计数
+
+    perf_last_cycles = 0;
+    perf_cycle_rem = 0;
+    perf_micros = 0;
+}
+
+/**
+ * @brief  CPU周期数转换为微秒
+ * @param  cycles: CPU周期数
+ * @retval 耗时(us)
+ */
+float Perf_CyclesToUs(uint32_t cycles) {
+    return (float)cycles * 1000000.0f / (float)SystemCoreClock;
+}
+
+/**
+ * @brief  读取微秒时间戳
+ * @retval 上电以来的微秒数 (32位回绕)
+ * @note   按周期增量累加，只用32位运算；两次调用间隔需小于CYCCNT回绕周期(168MHz下约25.6s)，
+ *         gary_task每1ms调用一次即可保证。主循环与中断回调均可调用(短暂关中断)
+ */
+uint32_t Perf_GetMicros(void) {
+    uint32_t primask = __get_PRIMASK();
+    uint32_t cycles_per_us = SystemCoreClock / 1000000U;
+    uint32_t now, us;
+
+    __disable_irq();
+    now = DWT->CYCCNT;
+    perf_cycle_rem += now - perf_last_cycles;
+    perf_last_cycles = now;
+    perf_micros += perf_cycle_rem / cycles_per_us;
+    perf_cycle_rem %= cycles_per_us;
+    us = perf_micros;
+    __set_PRIMASK(primask);
+
+    return us;
+}
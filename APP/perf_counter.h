@@ -0,0 +1,32 @@
+/**
+ * @file perf_counter.h
+ * @brief 性能计数模块头文件 - 基于DWT周期计数器的代码耗时测量
+ */
+#ifndef PERF_COUNTER_H
+#define PERF_COUNTER_H
+
+#include "mydefine.h"
+
+/**
+ * @brief 性能计数器初始化函数 (使能DWT CYCCNT)
+ */
+void Perf_Init(void);
+
+/**
+ * @brief 读取当前CPU周期计数 (168MHz下约25.6s回绕，差值运算自动处理回绕)
+ */
+static inline uint32_t Perf_GetCycles(void) {
+    return DWT->CYCCNT;
+}
+
+/**
+ * @brief CPU周期数转换为微秒
+ */
+float Perf_CyclesToUs(uint32_t cycles);
+
+/**
+ * @brief 读取微秒时间戳 (DWT周期计数扩展，约71.6分钟回绕，差值运算自动处理回绕)
+ */
+uint32_t Perf_GetMicros(void);
+
+#endif
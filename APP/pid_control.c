@@ -3,124 +3,340 @@
 float basic_speed = 0.3f;
 float line_error;
 float pid_line_out;
+float yaw_rate_cmd;                 // 循线环输出的角速度指令(rad/s)
 float yaw;
 float pid_yaw_out;
 
-PID_T PID_left_speed;
-PID_T PID_right_speed;
+PID_Bank_T PID_speed_bank;          // 左右轮速度环控制器组，一次遍历同时更新
 PID_T PID_line;
 PID_T PID_Angle;
 
-pid_params_t left_speed = {
-    .Kp = 500.0f,
-    .Ki = 16.0f,
-    .Kd = 0.0f,
-    .out_max = 999.0f,
-    .out_min = -999.0f,
-};
-
-pid_params_t right_speed = {
-    .Kp = 500.0f,
-    .Ki = 16.0f,
-    .Kd = 0.0f,
-    .out_max = 999.0f,
-    .out_min = -999.0f,
-};
-
-
-pid_params_t line = {
-    .Kp = 0.2f,
-    .Ki = 0.0f,
-    .Kd = 100.0f,
-    .out_max = 0.2f,
-    .out_min = -0.2f,
-};
-
-pid_params_t Angle = {
-    .Kp = 0,
-    .Ki = 0.0f,
-    .Kd = 0,
-    .out_max = 0.0f,
-    .out_min = 0.0f,
-};
+Body_Velocity_t body_velocity = {0};
+
+// 采样时间对齐：样本按各自采集时刻记录，控制器在同一控制时刻取值
+static uint32_t pid_ctrl_us;                              // 本周期控制时刻(us)
+static Sample_History_t line_error_hist;                  // 循线偏差样本 (Gary)
+static Sample_History_t wheel_speed_hist[PID_SPEED_NUM];  // 轮速样本 (编码器滑动平均窗口中点)
+
+Decel_Control_t decel_control = {.enabled = DECEL_BRAKE_ENABLE};
+
+// PID参数(left_speed等)、参数双缓冲及循线/逆运动学计算见pid_core.c
 
 void PID_init(void) {
-    pid_init(&PID_left_speed,left_speed.Kp,left_speed.Ki,left_speed.Kd,
-        0.0f,left_speed.out_max);
+    PID_Params_Init();
 
-    pid_init(&PID_right_speed,right_speed.Kp,right_speed.Ki,right_speed.Kd,
-        0.0f,right_speed.out_max);
+    pid_bank_init(&PID_speed_bank, PID_SPEED_NUM);
+    pid_bank_set_params(&PID_speed_bank, PID_SPEED_LEFT, left_speed.Kp, left_speed.Ki, left_speed.Kd);
+    pid_bank_set_limit(&PID_speed_bank, PID_SPEED_LEFT, left_speed.out_min, left_speed.out_max);
+    pid_bank_set_params(&PID_speed_bank, PID_SPEED_RIGHT, right_speed.Kp, right_speed.Ki, right_speed.Kd);
+    pid_bank_set_limit(&PID_speed_bank, PID_SPEED_RIGHT, right_speed.out_min, right_speed.out_max);
 
     pid_init(&PID_line,line.Kp,line.Ki,line.Kd,0.0f,line.out_max);
 
     pid_init(&PID_Angle,Angle.Kp,Angle.Ki,Angle.Kd,0.0f,Angle.out_max);
 
-    pid_set_target(&PID_left_speed,basic_speed);
-    pid_set_target(&PID_right_speed,basic_speed);
+    pid_bank_set_target(&PID_speed_bank, PID_SPEED_LEFT, basic_speed);
+    pid_bank_set_target(&PID_speed_bank, PID_SPEED_RIGHT, basic_speed);
     pid_set_target(&PID_line,0.0f);
     pid_set_target(&PID_Angle,0.0f);
+
+    Profile_Init(&speed_profile, PROFILE_MAX_ACCEL, PROFILE_MAX_JERK);
+    Profile_SetDecel(&speed_profile, PROFILE_MAX_DECEL);
+    Profile_SetTarget(&speed_profile, basic_speed);
+
+    Recovery_Init(&line_recovery);
+    Planner_Init(&speed_planner);
+    Fusion_Init(&yaw_fusion, FUSION_CROSSOVER_HZ);
+    Track_Init(&track_map);
+    Shape_Init(&motor_shape);
 }
 
 // 添加PID重置函数供外部调用
 void PID_reset_all(void) {
-    pid_reset(&PID_left_speed);
-    pid_reset(&PID_right_speed);
+    pid_bank_reset(&PID_speed_bank, PID_SPEED_LEFT);
+    pid_bank_reset(&PID_speed_bank, PID_SPEED_RIGHT);
+    decel_control.braking[PID_SPEED_LEFT] = 0;
+    decel_control.braking[PID_SPEED_RIGHT] = 0;
     pid_reset(&PID_line);
     pid_reset(&PID_Angle);
 }
 
-// 更新PID参数并重新初始化
-void PID_update_params(void) {
-    // 更新左轮速度环PID参数
-    pid_set_params(&PID_left_speed, left_speed.Kp, left_speed.Ki, left_speed.Kd);
-    pid_set_limit(&PID_left_speed, left_speed.out_max);
-    
-    // 更新右轮速度环PID参数
-    pid_set_params(&PID_right_speed, right_speed.Kp, right_speed.Ki, right_speed.Kd);
-    pid_set_limit(&PID_right_speed, right_speed.out_max);
-    
-    // 更新循线环PID参数
-    pid_set_params(&PID_line, line.Kp, line.Ki, line.Kd);
-    pid_set_limit(&PID_line, line.out_max);
-    
-    // 更新角度环PID参数
-    pid_set_params(&PID_Angle, Angle.Kp, Angle.Ki, Angle.Kd);
-    pid_set_limit(&PID_Angle, Angle.out_max);
-    
-    // 重置所有PID控制器，清除历史数据
-    PID_reset_all();
+
+// 控制周期边界：切换参数块并无扰应用到各控制器
+static void PID_apply_pending_params(void) {
+    const pid_params_t *bank = PID_TakePendingParams();
+    if (bank == NULL) return;
+
+    // 速度环控制器组为差分方程形式，以上一次输出为起点累加，直接换系数即无扰
+    pid_bank_set_params(&PID_speed_bank, PID_SPEED_LEFT, bank[PID_CTRL_LEFT].Kp, bank[PID_CTRL_LEFT].Ki, bank[PID_CTRL_LEFT].Kd);
+    pid_bank_set_limit(&PID_speed_bank, PID_SPEED_LEFT, bank[PID_CTRL_LEFT].out_min, bank[PID_CTRL_LEFT].out_max);
+
+    pid_bank_set_params(&PID_speed_bank, PID_SPEED_RIGHT, bank[PID_CTRL_RIGHT].Kp, bank[PID_CTRL_RIGHT].Ki, bank[PID_CTRL_RIGHT].Kd);
+    pid_bank_set_limit(&PID_speed_bank, PID_SPEED_RIGHT, bank[PID_CTRL_RIGHT].out_min, bank[PID_CTRL_RIGHT].out_max);
+
+    // 位置式控制器反算积分项，保持输出连续 (积分项按新限幅约束，先换限幅)
+    pid_set_limit(&PID_line, bank[PID_CTRL_LINE].out_max);
+    pid_set_params_bumpless(&PID_line, bank[PID_CTRL_LINE].Kp, bank[PID_CTRL_LINE].Ki, bank[PID_CTRL_LINE].Kd);
+
+    // 增量式控制器输出自身累加，直接换参数即为无扰切换
+    pid_set_params(&PID_Angle, bank[PID_CTRL_ANGLE].Kp, bank[PID_CTRL_ANGLE].Ki, bank[PID_CTRL_ANGLE].Kd);
+    pid_set_limit(&PID_Angle, bank[PID_CTRL_ANGLE].out_max);
 }
 
+
 void PID_Line_Control(void) {
-    line_error = Gary_GetLineError() / 4.0f;
-    pid_line_out= pid_calculate_positional(&PID_line, line_error);
-    pid_line_out = pid_constrain(pid_line_out,line.out_min,line.out_max);
+    float gary_error = Sample_At(&line_error_hist, pid_ctrl_us); // 对齐到控制时刻的循线偏差
+    line_error = gary_error / 4.0f;
+    yaw_rate_cmd = PID_Line_Calc(&PID_line, PID_GetActiveParams(PID_CTRL_LINE), gary_error);
+    pid_line_out = -yaw_rate_cmd;
+}
+
 
-    pid_set_target(&PID_left_speed,basic_speed + pid_line_out);
-    pid_set_target(&PID_right_speed,basic_speed - pid_line_out);
+/**
+ * @brief 车体速度控制 - (v, ω)逆运动学结果写入左右轮速度环目标
+ * @param v 线速度指令(m/s)
+ * @param omega 角速度指令(rad/s，逆时针为正)
+ */
+void PID_Body_Velocity_Control(float v, float omega) {
+    PID_Body_Velocity_Calc(v, omega, &body_velocity);
+
+    pid_bank_set_target(&PID_speed_bank, PID_SPEED_LEFT, body_velocity.left_target);
+    pid_bank_set_target(&PID_speed_bank, PID_SPEED_RIGHT, body_velocity.right_target);
 }
 
 void PID_Angle_Control(void) {
-    yaw = imu_data.yaw;
+    // 连续航向，跨±180度不会产生360度误差；按去零偏角速度外推到本周期控制时刻
+    yaw = Sample_Extrapolate(Heading_Get(&heading_data), Heading_GetYawRate(&heading_data),
+                             imu_data.sample_us, pid_ctrl_us);
     pid_yaw_out = pid_calculate_incremental(&PID_Angle,yaw);
 }
 
+/**
+ * @brief 记录各传感器最新样本及其采集时刻，供控制时刻对齐
+ * @param line_found 当前是否检测到线 (丢线时清空偏差历史，重新找到线后不跨越丢线区间外推)
+ */
+static void PID_Record_Samples(uint8_t line_found) {
+    if (line_found) {
+        Sample_Push(&line_error_hist, Gary_GetLineError(), gary_data.sample_us);
+    } else {
+        Sample_Reset(&line_error_hist);
+    }
+    Sample_Push(&wheel_speed_hist[PID_SPEED_LEFT], get_left_wheel_speed_ms(), encoder_data_A.speed_time_us);
+    Sample_Push(&wheel_speed_hist[PID_SPEED_RIGHT], get_right_wheel_speed_ms(), encoder_data_B.speed_time_us);
+}
+
+/**
+ * @brief 角速度融合更新 (电机停止时也运行，保持融合航向连续)
+ * @note 陀螺仪取航向模块去零偏后的GZ，编码器取对齐到控制时刻的轮速差
+ */
+static void PID_Update_YawRate(void) {
+    float omega_enc = (Sample_At(&wheel_speed_hist[PID_SPEED_RIGHT], pid_ctrl_us)
+                     - Sample_At(&wheel_speed_hist[PID_SPEED_LEFT], pid_ctrl_us)) / WHEEL_BASE;
+    float omega_gyro = Heading_GetYawRate(&heading_data) * (3.14159f / 180.0f);
+
+    Fusion_Update(&yaw_fusion, omega_gyro, IMU_IsDataReady(), omega_enc, PID_CONTROL_PERIOD_S, HAL_GetTick());
+}
+
+/**
+ * @brief 减速控制器 - 超速量大于DECEL_BRAKE_ENTER时改为短路制动，小于DECEL_BRAKE_EXIT时恢复驱动
+ * 速度环此时输出为负，反向驱动(反接制动)电流大且到零速后会反转；短路制动只消耗动能。
+ * 制动强度按超速量比例调制；退出制动时速度环清零，避免积分在制动期间反向累积。
+ * 编码器轮速为幅值，目标为负(原地转向内侧轮)时不判断。
+ * @param c 速度环通道
+ * @param measured 对齐到控制时刻的轮速(m/s)
+ * @retval 制动强度 (0: 驱动)
+ */
+static uint16_t PID_Decel_Control(uint8_t c, float measured) {
+    float target = PID_speed_bank.target[c];
+    float over = measured - target;
+
+    if (!decel_control.enabled || target < 0.0f) {
+        decel_control.braking[c] = 0;
+    } else if (!decel_control.braking[c]) {
+        if (over >= DECEL_BRAKE_ENTER) {
+            decel_control.braking[c] = 1;
+            decel_control.brake_count[c]++;
+        }
+    } else if (over < DECEL_BRAKE_EXIT) {
+        decel_control.braking[c] = 0;
+        pid_bank_reset(&PID_speed_bank, c);
+    }
+
+    if (!decel_control.braking[c]) {
+        decel_control.strength[c] = 0;
+        return 0;
+    }
+
+    float strength = over / DECEL_BRAKE_FULL_ERR * (float)MOTOR_BRAKE_FULL;
+    if (strength < 1.0f) strength = 1.0f;
+    if (strength > (float)MOTOR_BRAKE_FULL) strength = (float)MOTOR_BRAKE_FULL;
+    decel_control.strength[c] = (uint16_t)strength;
+    decel_control.brake_ms[c] += (uint32_t)(PID_CONTROL_PERIOD_S * 1000.0f);
+    return decel_control.strength[c];
+}
+
 void pid_task(void) {
+    PID_apply_pending_params(); // 控制周期边界切换参数块(电机停止时也要生效)
+
+    // 样本记录与角速度融合 (电机未使能时也更新)
+    uint8_t line_found = Gary_IsLineFound();
+    pid_ctrl_us = Perf_GetMicros();
+    PID_Record_Samples(line_found);
+    PID_Update_YawRate();
+
+    // 电机特性标定：扫描期间接管电机输出，stop中止
+    if (Shape_IsCharacterizing(&motor_shape)) {
+        if (!enable) {
+            Shape_StopCharacterize(&motor_shape);  // stop已制动停车
+            return;
+        }
+        int32_t char_pwm = Shape_CharUpdate(&motor_shape, get_left_wheel_speed_ms(), get_right_wheel_speed_ms(), HAL_GetTick());
+        char_pwm = Battery_ScalePwm(&battery, char_pwm);  // 扫描结果折算到VBAT_NOMINAL电压
+        Motor_SetSpeedPair(&motor1, char_pwm, &motor2, char_pwm, 1);
+        if (!Shape_IsCharacterizing(&motor_shape)) {
+            Motor_StartStop();
+            my_printf(&huart2,"电机特性标定%s，输入motor查看\r\n", Shape_GetCharStateName(motor_shape.char_state));
+        }
+        return;
+    }
+
     if (!enable) return; // 安全检查：电机未使能时直接返回
 
-    PID_Line_Control();
+    // 循线环只在检测到线时计算，丢线期间由恢复状态机接管(v, ω)
+    if (line_found) {
+        // 转向/搜索后重新找到线：以当前偏差为历史误差重置，丢线前的偏差和积分不参与，
+        // 首拍微分项为0；HOLD期间只是短暂断线，控制器状态保持连续
+        if (line_recovery.state == RECOVERY_STEER || line_recovery.state == RECOVERY_SEARCH) {
+            pid_reset_to(&PID_line, PID_line.target - Sample_At(&line_error_hist, pid_ctrl_us) / 4.0f);
+        }
+        PID_Line_Control();
+    }
+    // 曲率自适应：按横向加速度限制给出线速度目标(未使能时为basic_speed)
+    // 偏差取循线环使用的控制时刻对齐值(line_error)，丢线时不使用
+    float v_nominal = Planner_Update(&speed_planner, basic_speed, line_found, line_error * 4.0f, PID_CONTROL_PERIOD_S);
+
+    // 赛道学习：按里程记录/定位，跟随时由地图速度曲线提前减速
+    float ds = 0.5f * (get_left_wheel_speed_ms() + get_right_wheel_speed_ms()) * PID_CONTROL_PERIOD_S;
+    Track_Update(&track_map, ds, speed_planner.kappa_body, Classifier_TakeEvents(&line_classifier), HAL_GetTick());
+    if (track_map.mode == TRACK_RUNNING) {
+        v_nominal = Track_GetSpeed(&track_map);
+    }
+    Recovery_Update(&line_recovery, line_found, line_error * 4.0f, yaw_rate_cmd, v_nominal, HAL_GetTick());
+    Gary_SetSearching(Recovery_IsActive(&line_recovery));
 
-    float speed_current_left = get_left_wheel_speed_ms();
-    float speed_current_right = get_right_wheel_speed_ms();
-    float pid_left_out = pid_calculate_positional(&PID_left_speed,speed_current_left);
-    float pid_right_out = pid_calculate_positional(&PID_right_speed,speed_current_right);
-    pid_left_out = pid_constrain(pid_left_out,left_speed.out_min,left_speed.out_max);
-    pid_right_out = pid_constrain(pid_right_out,right_speed.out_min,right_speed.out_max);
-    Motor_SetSpeed(&motor1,(int32_t)pid_left_out,enable);
-    Motor_SetSpeed(&motor2,(int32_t)pid_right_out,enable);
-    my_printf(&huart2,"%0.2f,%0.2f,%0.2f,%0.2f\n",encoder_data_A.speed_m_s,encoder_data_B.speed_m_s,basic_speed - pid_line_out,basic_speed + pid_line_out);
+    // 速度规划：恢复状态机给出的线速度为目标，按加速度/加加速度限制平滑过渡
+    Profile_SetTarget(&speed_profile, line_recovery.v_target);
+    float v_ref = Profile_Update(&speed_profile, PID_CONTROL_PERIOD_S);
+
+    PID_Body_Velocity_Control(v_ref, line_recovery.omega);
+
+    // 左右轮速度环一次遍历更新，限幅在控制器组内完成 (轮速对齐到控制时刻)
+    float speed_current[PID_SPEED_NUM];
+    speed_current[PID_SPEED_LEFT] = Sample_At(&wheel_speed_hist[PID_SPEED_LEFT], pid_ctrl_us);
+    speed_current[PID_SPEED_RIGHT] = Sample_At(&wheel_speed_hist[PID_SPEED_RIGHT], pid_ctrl_us);
+    pid_bank_update(&PID_speed_bank, speed_current);
+
+    // 输出整形：死区补偿 + 线性化查找表，速度环输出与轮速近似成正比；再按电池电压补偿
+    // 速度环通道与电机ID一一对应 (PID_SPEED_LEFT = MOTOR_ID_LEFT)
+    Motor_t *wheel[PID_SPEED_NUM] = {&motor1, &motor2};
+    int32_t pwm[PID_SPEED_NUM];
+    uint16_t brake[PID_SPEED_NUM];
+    for (uint8_t c = 0; c < PID_SPEED_NUM; c++) {
+        brake[c] = PID_Decel_Control(c, speed_current[c]);
+        pwm[c] = Battery_ScalePwm(&battery, Shape_Apply(&motor_shape, c, PID_speed_bank.out[c]));
+    }
+    if (brake[PID_SPEED_LEFT] == 0 && brake[PID_SPEED_RIGHT] == 0) {
+        Motor_SetSpeedPair(wheel[PID_SPEED_LEFT], pwm[PID_SPEED_LEFT], wheel[PID_SPEED_RIGHT], pwm[PID_SPEED_RIGHT], enable);
+    } else {
+        for (uint8_t c = 0; c < PID_SPEED_NUM; c++) {
+            if (brake[c]) {
+                Motor_Brake(wheel[c], brake[c]);
+            } else {
+                Motor_SetSpeed(wheel[c], pwm[c], enable);
+            }
+        }
+    }
+    my_printf(&huart2,"%0.2f,%0.2f,%0.2f,%0.2f,%0.3f\n",encoder_data_A.speed_m_s,encoder_data_B.speed_m_s,body_velocity.left_target,body_velocity.right_target,battery.factor);
 
 }
 
+/**
+ * @brief 速度环计算耗时对比 - 逐个PID_T调用 vs 控制器组一次遍历
+ * @param iterations 每种实现的更新次数
+ * @note 使用当前速度环参数和合成的测量序列，两种实现输入相同，
+ *       同时给出输出最大偏差以确认结果一致。测量期间不关中断，取平均值
+ */
+void PID_Bench(uint32_t iterations) {
+    static float samples[32];
+    static volatile float sink;     // 防止计算结果被优化掉
+    const pid_params_t *bank = PID_GetActiveParams(PID_CTRL_LEFT); // 生效参数块，按pid_ctrl_id_t连续存放
+    PID_T ref[PID_SPEED_NUM];
+    PID_Bank_T batch;
+    float max_diff = 0.0f;
+
+    if (iterations == 0) return;
+
+    // 合成测量序列：0~0.6m/s之间往复，覆盖饱和与非饱和区
+    for (uint8_t i = 0; i < 32; i++) {
+        samples[i] = 0.3f + 0.3f * sinf((float)i * 0.19635f);
+    }
 
+    for (uint8_t c = 0; c < PID_SPEED_NUM; c++) {
+        pid_init(&ref[c], bank[c].Kp, bank[c].Ki, bank[c].Kd, 0.3f, bank[c].out_max);
+    }
+    pid_bank_init(&batch, PID_SPEED_NUM);
+    for (uint8_t c = 0; c < PID_SPEED_NUM; c++) {
+        pid_bank_set_params(&batch, c, bank[c].Kp, bank[c].Ki, bank[c].Kd);
+        pid_bank_set_limit(&batch, c, bank[c].out_min, bank[c].out_max);
+        pid_bank_set_target(&batch, c, 0.3f);
+    }
 
+    // 原实现：每个控制器一次函数调用 + 单独限幅
+    uint32_t start = Perf_GetCycles();
+    for (uint32_t n = 0; n < iterations; n++) {
+        float meas = samples[n & 31];
+        float out_l = pid_constrain(pid_calculate_positional(&ref[PID_SPEED_LEFT], meas),
+            bank[PID_CTRL_LEFT].out_min, bank[PID_CTRL_LEFT].out_max);
+        float out_r = pid_constrain(pid_calculate_positional(&ref[PID_SPEED_RIGHT], meas),
+            bank[PID_CTRL_RIGHT].out_min, bank[PID_CTRL_RIGHT].out_max);
+        sink = out_l + out_r;
+    }
+    uint32_t cycles_ref = Perf_GetCycles() - start;
+
+    // 控制器组：一次遍历更新全部控制器
+    float meas_pair[PID_SPEED_NUM];
+    start = Perf_GetCycles();
+    for (uint32_t n = 0; n < iterations; n++) {
+        meas_pair[PID_SPEED_LEFT] = samples[n & 31];
+        meas_pair[PID_SPEED_RIGHT] = samples[n & 31];
+        pid_bank_update(&batch, meas_pair);
+        sink = batch.out[PID_SPEED_LEFT] + batch.out[PID_SPEED_RIGHT];
+    }
+    uint32_t cycles_bank = Perf_GetCycles() - start;
+
+    // 结果一致性：重新以相同输入逐拍对比
+    for (uint8_t c = 0; c < PID_SPEED_NUM; c++) {
+        pid_reset(&ref[c]);
+        pid_bank_reset(&batch, c);
+    }
+    for (uint32_t n = 0; n < 256; n++) {
+        meas_pair[PID_SPEED_LEFT] = samples[n & 31];
+        meas_pair[PID_SPEED_RIGHT] = samples[n & 31];
+        pid_bank_update(&batch, meas_pair);
+        for (uint8_t c = 0; c < PID_SPEED_NUM; c++) {
+            float out_ref = pid_constrain(pid_calculate_positional(&ref[c], meas_pair[c]),
+                bank[c].out_min, bank[c].out_max);
+            float diff = fabsf(out_ref - batch.out[c]);
+            if (diff > max_diff) max_diff = diff;
+        }
+    }
+
+    float per_ref = (float)cycles_ref / (float)iterations;
+    float per_bank = (float)cycles_bank / (float)iterations;
+    my_printf(&huart2,"=== 速度环计算耗时 (%lu次, 双控制器) ===\r\n", iterations);
+    my_printf(&huart2,"PID_T逐个计算: %.1f cycles/次 (%.2f us)\r\n", per_ref, Perf_CyclesToUs((uint32_t)per_ref));
+    my_printf(&huart2,"控制器组批量:  %.1f cycles/次 (%.2f us)\r\n", per_bank, Perf_CyclesToUs((uint32_t)per_bank));
+    my_printf(&huart2,"加速比: %.2fx\r\n", per_bank > 0.0f ? per_ref / per_bank : 0.0f);
+    my_printf(&huart2,"输出最大偏差: %.6f\r\n", max_diff);
+    (void)sink;
+}
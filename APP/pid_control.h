@@ -11,11 +11,49 @@ typedef struct {
     float out_min;
 }pid_params_t;
 
+// 控制器编号 (参数双缓冲块索引)
+typedef enum {
+    PID_CTRL_LEFT = 0,        // 左轮速度环
+    PID_CTRL_RIGHT,           // 右轮速度环
+    PID_CTRL_LINE,            // 循线环
+    PID_CTRL_ANGLE,           // 角度环
+    PID_CTRL_NUM
+} pid_ctrl_id_t;
+
+// 速度环控制器组编号
+typedef enum {
+    PID_SPEED_LEFT = 0,       // 左轮速度环 (与PID_CTRL_LEFT一致)
+    PID_SPEED_RIGHT,          // 右轮速度环 (与PID_CTRL_RIGHT一致)
+    PID_SPEED_NUM
+} pid_speed_id_t;
+
+// 车体速度控制数据结构 (v, ω) - 逆运动学输出左右轮目标速度
+typedef struct {
+    float v_cmd;              // 速度规划给出的线速度指令(m/s)
+    float omega_cmd;          // 循线/航向环给出的角速度指令(rad/s，逆时针为正)
+    float v_out;              // 饱和处理后的线速度(m/s)
+    float omega_out;          // 饱和处理后的角速度(rad/s)
+    float left_target;        // 左轮目标速度(m/s)
+    float right_target;       // 右轮目标速度(m/s)
+    uint8_t saturated;        // 饱和标志 (1: 已缩减v以优先保证ω)
+} Body_Velocity_t;
+
+// 减速控制器数据结构 - 轮速超出目标较多时以短路制动代替反向驱动
+typedef struct {
+    uint8_t enabled;                      // 使能
+    uint8_t braking[PID_SPEED_NUM];       // 该轮正在制动
+    uint16_t strength[PID_SPEED_NUM];     // 本周期制动强度 (0~MOTOR_BRAKE_FULL)
+    uint32_t brake_count[PID_SPEED_NUM];  // 进入制动次数
+    uint32_t brake_ms[PID_SPEED_NUM];     // 累计制动时间(ms)
+} Decel_Control_t;
+
 extern float basic_speed;
 extern float line_error;
 extern float pid_line_out;
-extern PID_T PID_left_speed;
-extern PID_T PID_right_speed;
+extern float yaw_rate_cmd;
+extern Body_Velocity_t body_velocity;
+extern Decel_Control_t decel_control;
+extern PID_Bank_T PID_speed_bank;
 extern PID_T PID_line;
 extern PID_T PID_Angle;
 
@@ -29,8 +67,26 @@ extern pid_params_t Angle;
  */
 void PID_init(void);
 
+/**
+ * @brief 循线环 - 由位置偏差计算角速度指令yaw_rate_cmd
+ */
 void PID_Line_Control(void);
 
+/**
+ * @brief 循线环计算 - 灰度偏差转换为角速度指令 (不读取传感器)
+ */
+float PID_Line_Calc(PID_T *pid, const pid_params_t *params, float gary_error);
+
+/**
+ * @brief 车体速度逆运动学计算 (结果写入bv，不修改控制器)
+ */
+void PID_Body_Velocity_Calc(float v, float omega, Body_Velocity_t *bv);
+
+/**
+ * @brief 车体速度控制 - (v, ω)逆运动学转换为左右轮目标速度
+ */
+void PID_Body_Velocity_Control(float v, float omega);
+
 /**
  * @brief 调度器运行函数
  */
@@ -42,8 +98,28 @@ void pid_task(void);
 void PID_reset_all(void);
 
 /**
- * @brief 更新PID参数并重新初始化
+ * @brief 提交PID参数 (写入后台参数块，下一控制周期无扰切换)
  */
 void PID_update_params(void);
 
+/**
+ * @brief 获取当前生效的PID参数块
+ */
+const pid_params_t* PID_GetActiveParams(pid_ctrl_id_t id);
+
+/**
+ * @brief 参数双缓冲初始化 (两个参数块均取编辑区当前值)
+ */
+void PID_Params_Init(void);
+
+/**
+ * @brief 控制周期边界切换参数块 - 返回新生效块，无待切换参数时返回NULL
+ */
+const pid_params_t* PID_TakePendingParams(void);
+
+/**
+ * @brief 速度环计算耗时对比 (PID_T逐个计算 vs 控制器组批量计算)
+ */
+void PID_Bench(uint32_t iterations);
+
 #endif
\ No newline at end of file
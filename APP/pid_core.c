@@ -0,0 +1,132 @@
+/**
+ * @file pid_core.c
+ * @brief PID控制核心 - 控制参数、参数双缓冲、循线环与车体逆运动学计算
+ * @note 本文件不访问传感器和外设，pid_task与闭环基准仿真共用；
+ *       主机端测试工程(tests/)直接编译本文件，API声明见pid_control.h
+ */
+#include "pid_control.h"
+
+pid_params_t left_speed = {
+    .Kp = 500.0f,
+    .Ki = 16.0f,
+    .Kd = 0.0f,
+    .out_max = 999.0f,
+    .out_min = -999.0f,
+};
+
+pid_params_t right_speed = {
+    .Kp = 500.0f,
+    .Ki = 16.0f,
+    .Kd = 0.0f,
+    .out_max = 999.0f,
+    .out_min = -999.0f,
+};
+
+
+// 循线环输出为角速度(rad/s)：原±0.2m/s轮速差 × 2/WHEEL_BASE 换算
+pid_params_t line = {
+    .Kp = 2.67f,
+    .Ki = 0.0f,
+    .Kd = 1333.0f,
+    .out_max = 2.67f,
+    .out_min = -2.67f,
+};
+
+pid_params_t Angle = {
+    .Kp = 0,
+    .Ki = 0.0f,
+    .Kd = 0,
+    .out_max = 0.0f,
+    .out_min = 0.0f,
+};
+
+// PID参数双缓冲：left_speed等为编辑区(串口指令修改)，控制环只读取生效块
+// PID_update_params()写入后台块并置位pending，pid_task在周期边界切换
+static pid_params_t pid_param_bank[2][PID_CTRL_NUM];
+static uint8_t pid_param_active = 0;            // 当前生效块索引
+static volatile uint8_t pid_param_pending = 0;  // 后台块待切换标志
+
+// 将编辑区参数拷贝到指定参数块
+static void pid_params_snapshot(pid_params_t *bank) {
+    bank[PID_CTRL_LEFT] = left_speed;
+    bank[PID_CTRL_RIGHT] = right_speed;
+    bank[PID_CTRL_LINE] = line;
+    bank[PID_CTRL_ANGLE] = Angle;
+}
+
+/**
+ * @brief 参数双缓冲初始化 - 两个参数块均取编辑区当前值
+ */
+void PID_Params_Init(void) {
+    pid_param_active = 0;
+    pid_param_pending = 0;
+    pid_params_snapshot(pid_param_bank[0]);
+    pid_params_snapshot(pid_param_bank[1]);
+}
+
+// 提交PID参数：写入后台块，由pid_task在控制周期边界切换，不清除积分
+void PID_update_params(void) {
+    pid_params_snapshot(pid_param_bank[pid_param_active ^ 1]);
+    pid_param_pending = 1;
+}
+
+const pid_params_t* PID_GetActiveParams(pid_ctrl_id_t id) {
+    return &pid_param_bank[pid_param_active][id];
+}
+
+/**
+ * @brief 控制周期边界取待切换参数块
+ * @retval 新的生效参数块(按pid_ctrl_id_t索引)，无待切换参数时返回NULL
+ */
+const pid_params_t* PID_TakePendingParams(void) {
+    if (!pid_param_pending) return NULL;
+
+    pid_param_active ^= 1;
+    pid_param_pending = 0;
+    return pid_param_bank[pid_param_active];
+}
+
+/**
+ * @brief 循线环计算 (供控制环与离线仿真共用)
+ * @param pid 循线环控制器
+ * @param params 循线环参数(取输出限幅)
+ * @param gary_error 灰度位置偏差(±4.0)
+ * @retval 角速度指令(rad/s，逆时针为正)
+ */
+float PID_Line_Calc(PID_T *pid, const pid_params_t *params, float gary_error) {
+    float out = pid_calculate_positional(pid, gary_error / 4.0f);
+    out = pid_constrain(out, params->out_min, params->out_max);
+
+    // PID输出为正时需左轮加速、右轮减速，即顺时针转向(ω为负)
+    return -out;
+}
+
+/**
+ * @brief 车体速度逆运动学计算 (不修改控制器，供控制环与离线仿真共用)
+ * @param v 线速度指令(m/s)
+ * @param omega 角速度指令(rad/s，逆时针为正)
+ * @param bv 计算结果输出
+ * @note v_left = v - ω·B/2, v_right = v + ω·B/2
+ *       轮速超过BODY_WHEEL_SPEED_MAX时优先保证ω，缩减v
+ */
+void PID_Body_Velocity_Calc(float v, float omega, Body_Velocity_t *bv) {
+    bv->v_cmd = v;
+    bv->omega_cmd = omega;
+    bv->saturated = 0;
+
+    // 角速度本身超限时先限幅(此时v只能为0)
+    omega = pid_constrain(omega, -BODY_OMEGA_MAX, BODY_OMEGA_MAX);
+    float half_diff = omega * (WHEEL_BASE * 0.5f);
+
+    // 留给线速度的余量 = 轮速上限 - 差速分量
+    float v_room = BODY_WHEEL_SPEED_MAX - fabsf(half_diff);
+    if (fabsf(v) > v_room) {
+        v = (v > 0.0f) ? v_room : -v_room;
+        bv->saturated = 1;
+    }
+
+    bv->v_out = v;
+    bv->omega_out = omega;
+    bv->left_target = v - half_diff;
+    bv->right_target = v + half_diff;
+}
@@ -0,0 +1,86 @@
+/**
+ * @file sample_align.c
+ * @brief 采样时间对齐模块实现 - 线性内插/外推
+ * @note IMU、编码器、Gary各自在采集时刻打微秒时间戳，控制器在同一控制时刻取值，
+ *       消除各传感器采样相位不同造成的相位误差。外推只用最近两个样本的斜率，
+ *       外推时长限制在SAMPLE_MAX_EXTRAP_US内，避免样本停更时输出发散。
+ */
+#include "sample_align.h"
+
+/**
+ * @brief 清空样本历史
+ * @param h 样本历史
+ */
+void Sample_Reset(Sample_History_t* h) {
+    if (h == NULL) return;
+    h->value[0] = h->value[1] = 0.0f;
+    h->time_us[0] = h->time_us[1] = 0;
+    h->count = 0;
+}
+
+/**
+ * @brief 记录一个新样本
+ * @param h 样本历史
+ * @param value 样本值
+ * @param time_us 采样时刻(us)
+ */
+void Sample_Push(Sample_History_t* h, float value, uint32_t time_us) {
+    if (h == NULL) return;
+
+    if (h->count > 0 && time_us == h->time_us[1]) {
+        h->value[1] = value;    // 同一样本重复读取
+        return;
+    }
+
+    h->value[0] = h->value[1];
+    h->time_us[0] = h->time_us[1];
+    h->value[1] = value;
+    h->time_us[1] = time_us;
+    if (h->count < 2) h->count++;
+}
+
+/**
+ * @brief 求指定时刻的样本值
+ * @param h 样本历史
+ * @param time_us 目标时刻(us)
+ * @return 目标时刻的估计值；样本不足或对齐未使能时返回最新样本
+ */
+float Sample_At(const Sample_History_t* h, uint32_t time_us) {
+    if (h == NULL || h->count == 0) return 0.0f;
+
+#if SAMPLE_ALIGN_ENABLE
+    if (h->count == 2) {
+        int32_t span = (int32_t)(h->time_us[1] - h->time_us[0]);
+        int32_t dt = (int32_t)(time_us - h->time_us[1]);
+        if (span > 0) {
+            // 早于上一样本时截断到两样本之间，晚于最新样本时限制外推时长
+            if (dt < -span) dt = -span;
+            if (dt > SAMPLE_MAX_EXTRAP_US) dt = SAMPLE_MAX_EXTRAP_US;
+            return h->value[1] + (h->value[1] - h->value[0]) * (float)dt / (float)span;
+        }
+    }
+#else
+    (void)time_us;
+#endif
+    return h->value[1];
+}
+
+/**
+ * @brief 已知变化率时外推到指定时刻
+ * @param value 样本值
+ * @param rate 变化率(单位/秒)
+ * @param sample_us 采样时刻(us)
+ * @param target_us 目标时刻(us)
+ * @return 目标时刻的估计值
+ */
+float Sample_Extrapolate(float value, float rate, uint32_t sample_us, uint32_t target_us) {
+#if SAMPLE_ALIGN_ENABLE
+    int32_t dt = Sample_AgeUs(sample_us, target_us);
+    if (dt > SAMPLE_MAX_EXTRAP_US) dt = SAMPLE_MAX_EXTRAP_US;
+    if (dt < -SAMPLE_MAX_EXTRAP_US) dt = -SAMPLE_MAX_EXTRAP_US;
+    return value + rate * (float)dt * 1e-6f;
+#else
+    (void)rate; (void)sample_us; (void)target_us;
+    return value;
+#endif
+}
@@ -0,0 +1,46 @@
+/**
+ * @file sample_align.h
+ * @brief 采样时间对齐模块头文件 - 按微秒采样时间戳对传感器样本做线性内插/外推
+ */
+#ifndef SAMPLE_ALIGN_H
+#define SAMPLE_ALIGN_H
+
+#include "mydefine.h"
+
+// 采样对齐配置参数已迁移到mydefine.h统一管理
+
+// 最近两个样本 (线性内插/外推用)
+typedef struct {
+    float value[2];                // 样本值，[1]为最新
+    uint32_t time_us[2];           // 对应采样时刻(us，Perf_GetMicros)
+    uint8_t count;                 // 有效样本数 (0-2)
+} Sample_History_t;
+
+/**
+ * @brief 清空样本历史
+ */
+void Sample_Reset(Sample_History_t* h);
+
+/**
+ * @brief 记录一个新样本 (时间戳与最新样本相同时视为同一样本，只更新值)
+ */
+void Sample_Push(Sample_History_t* h, float value, uint32_t time_us);
+
+/**
+ * @brief 求指定时刻的样本值 - 两样本之间内插，最新样本之后外推(限幅SAMPLE_MAX_EXTRAP_US)
+ */
+float Sample_At(const Sample_History_t* h, uint32_t time_us);
+
+/**
+ * @brief 已知变化率时外推到指定时刻 (如航向用角速度外推)
+ */
+float Sample_Extrapolate(float value, float rate, uint32_t sample_us, uint32_t target_us);
+
+/**
+ * @brief 样本年龄(us)，负值表示样本时刻晚于now_us
+ */
+static inline int32_t Sample_AgeUs(uint32_t sample_us, uint32_t now_us) {
+    return (int32_t)(now_us - sample_us);
+}
+
+#endif
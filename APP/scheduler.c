@@ -22,7 +22,7 @@ static task_t scheduler_task[] =
     {motor_task,1,0},    // 电机控制任务，1ms周期（最高优先级）
     {pid_task,10,0},
     {imu_task,10,0},    // IMU任务，20ms周期，15ms偏移
-    {gary_task,10,0},    // Gary灰度传感器任务，20ms周期
+    {gary_task,1,0},     // Gary灰度传感器任务，1ms周期（DMA非阻塞采样）
     {encoder_task,10,0}, // 编码器任务，20ms周期，10ms偏移
     {oled_task,100,0},   // OLED显示任务，100ms周期
     {adc_task,50,0}      // ADC采集任务，50ms周期
@@ -0,0 +1,115 @@
+/**
+ * @file speed_planner.c
+ * @brief 曲率自适应速度规划模块实现 - 在线估计路径曲率，按横向加速度限制给出线速度目标
+ * @note 三路曲率来源，取较大值保证安全：
+ *       1. 车体曲率 κ_body = ω/v，ω由IMU偏航角速度与左右轮速差(vR-vL)/B加权融合
+ *       2. 偏差几何曲率 κ_line = 2y/L²：循线稳态时传感器(距驱动轴L)处横向偏移
+ *          y与路径曲率近似满足 y = κL²/2，入弯时先于车体转向出现
+ *       3. 曲率增长率 κ_rate = 2ẏ/L²：偏移正在增大时按PLANNER_LOOKAHEAD_S前瞻提前减速
+ *       规划曲率快升慢降(释放时间常数PLANNER_KAPPA_RELEASE_S)，出弯后逐渐恢复直道速度。
+ *       v = sqrt(a_lat/κ)，限幅到[v_min, v_max]，再交由motion_profile按加速度/加加速度平滑。
+ */
+#include "speed_planner.h"
+
+Speed_Planner_t speed_planner;
+
+/**
+ * @brief 速度规划器初始化函数
+ * @param planner 规划器指针
+ */
+void Planner_Init(Speed_Planner_t* planner) {
+    if (planner == NULL) return;
+
+    memset(planner, 0, sizeof(*planner));
+    planner->enabled = 0;
+    planner->v_min = PLANNER_V_MIN;
+    Planner_SetLimits(planner, PLANNER_LAT_ACCEL, PLANNER_V_MAX);
+}
+
+/**
+ * @brief 设置横向加速度限制和直道最高速度
+ * @param planner 规划器指针
+ * @param a_lat 横向加速度限制(m/s²)
+ * @param v_max 直道最高速度(m/s)
+ */
+void Planner_SetLimits(Speed_Planner_t* planner, float a_lat, float v_max) {
+    if (planner == NULL) return;
+
+    planner->a_lat = (a_lat > 0.0f) ? a_lat : PLANNER_LAT_ACCEL;
+    planner->v_max = (v_max > planner->v_min) ? v_max : planner->v_min;
+}
+
+/**
+ * @brief 使能/禁用曲率自适应
+ * @param planner 规划器指针
+ * @param enable 1: 按曲率规划, 0: 使用basic_speed
+ */
+void Planner_Enable(Speed_Planner_t* planner, uint8_t enable) {
+    if (planner == NULL) return;
+
+    planner->enabled = enable ? 1 : 0;
+    planner->kappa = 0.0f;
+}
+
+/**
+ * @brief 获取实测角速度幅值
+ * @note 取角速度融合模块输出 (陀螺仪高通 + 编码器低通，打滑时只用陀螺仪)
+ */
+static float Planner_MeasureYawRate(Speed_Planner_t* planner) {
+    planner->yaw_rate = Fusion_GetYawRate(&yaw_fusion);
+    return fabsf(planner->yaw_rate);
+}
+
+/**
+ * @brief 速度规划周期更新函数
+ * @param planner 规划器指针
+ * @param v_nominal 未使能时的线速度目标(m/s)，即basic_speed
+ * @param line_found 本周期是否检测到线 (丢线时偏差无效，保持曲率)
+ * @param gary_error 灰度位置偏差(±4.0)，与循线环相同的控制时刻对齐值
+ * @param dt 控制周期(s)
+ * @retval 线速度目标(m/s)
+ */
+float Planner_Update(Speed_Planner_t* planner, float v_nominal, uint8_t line_found, float gary_error, float dt) {
+    if (planner == NULL) return v_nominal;
+
+    // 1. 车体曲率 (低速时ω/v不可靠，不参与)
+    float v_meas = 0.5f * (get_left_wheel_speed_ms() + get_right_wheel_speed_ms());
+    float omega = Planner_MeasureYawRate(planner);
+    planner->kappa_body = (v_meas > PLANNER_V_EST_MIN) ? omega / v_meas : 0.0f;
+
+    // 2. 偏差几何曲率与增长率
+    if (line_found) {
+        float offset = fabsf(gary_error) * GARY_SENSOR_PITCH_M;
+
+        planner->kappa_line = 2.0f * offset / (GARY_SENSOR_LOOKAHEAD_M * GARY_SENSOR_LOOKAHEAD_M);
+        // 丢线后重新找到线：上次偏移已过时，差分会得到虚假的增长率，本周期只记录偏移
+        if (planner->line_valid) {
+            float rate = (offset - planner->prev_offset) / dt;
+            float alpha = dt / (PLANNER_RATE_TAU_S + dt);
+            planner->kappa_rate += alpha * (2.0f * rate / (GARY_SENSOR_LOOKAHEAD_M * GARY_SENSOR_LOOKAHEAD_M) - planner->kappa_rate);
+        }
+        planner->prev_offset = offset;
+    }
+    planner->line_valid = line_found;
+
+    // 3. 规划曲率：取较大值并加前瞻，快升慢降
+    float kappa = (planner->kappa_body > planner->kappa_line) ? planner->kappa_body : planner->kappa_line;
+    if (planner->kappa_rate > 0.0f) {
+        kappa += planner->kappa_rate * PLANNER_LOOKAHEAD_S;
+    }
+    if (kappa > planner->kappa) {
+        planner->kappa = kappa;
+    } else {
+        planner->kappa += dt / (PLANNER_KAPPA_RELEASE_S + dt) * (kappa - planner->kappa);
+    }
+
+    // 4. v = sqrt(a_lat/κ)
+    float v = planner->v_max;
+    if (planner->kappa * planner->v_max * planner->v_max > planner->a_lat) {
+        v = sqrtf(planner->a_lat / planner->kappa);
+    }
+    if (v < planner->v_min) v = planner->v_min;
+    planner->v_target = v;
+
+    return planner->enabled ? planner->v_target : v_nominal;
+}
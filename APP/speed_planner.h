@@ -0,0 +1,53 @@
+/**
+ * @file speed_planner.h
+ * @brief 曲率自适应速度规划模块头文件 - 在线估计路径曲率，按横向加速度限制给出线速度目标
+ */
+#ifndef SPEED_PLANNER_H
+#define SPEED_PLANNER_H
+
+#include "mydefine.h"
+
+// 速度规划器配置参数已迁移到mydefine.h统一管理
+
+// 曲率自适应速度规划器数据结构
+typedef struct {
+    uint8_t enabled;                   // 使能标志 (0: 直接使用basic_speed)
+    float a_lat;                       // 横向加速度限制(m/s²)
+    float v_max;                       // 直道最高速度(m/s)
+    float v_min;                       // 弯道最低速度(m/s)
+
+    float yaw_rate;                    // 融合后的实测角速度(rad/s)
+    float kappa_body;                  // 车体曲率 ω/v (1/m)
+    float kappa_line;                  // 灰度偏差几何曲率 2y/L² (1/m)
+    float kappa_rate;                  // 曲率增长率(1/m/s)，由偏差变化率得到
+    float kappa;                       // 含前瞻的规划曲率(1/m)，快升慢降
+    float v_target;                    // 输出线速度目标(m/s)
+
+    float prev_offset;                 // 上周期横向偏移(m)
+    uint8_t line_valid;                // prev_offset有效 (丢线后首次找到线时只记录偏移，不计算增长率)
+} Speed_Planner_t;
+
+// 全局速度规划器 (pid_task中循线环之前调用)
+extern Speed_Planner_t speed_planner;
+
+/**
+ * @brief 速度规划器初始化函数
+ */
+void Planner_Init(Speed_Planner_t* planner);
+
+/**
+ * @brief 设置横向加速度限制和直道最高速度
+ */
+void Planner_SetLimits(Speed_Planner_t* planner, float a_lat, float v_max);
+
+/**
+ * @brief 使能/禁用曲率自适应
+ */
+void Planner_Enable(Speed_Planner_t* planner, uint8_t enable);
+
+/**
+ * @brief 速度规划周期更新函数 - 返回线速度目标
+ */
+float Planner_Update(Speed_Planner_t* planner, float v_nominal, uint8_t line_found, float gary_error, float dt);
+
+#endif
@@ -0,0 +1,332 @@
+/**
+ * @file track_map.c
+ * @brief 赛道学习模块实现 - 首圈按里程记录曲率与路口事件，后续圈定位并按预计算速度曲线行驶
+ * @note 1. 学习：从起跑线出发，按轮式里程每TRACK_BIN_M一格记录平均车体曲率和循线事件，
+ *          再次进入路口且里程≥TRACK_MIN_LAP_M、航向与起点一致时闭合一圈(也可手动闭合)
+ *       2. 速度曲线：每格 v=sqrt(a_lat/κ) 限幅后，按速度规划加速度做环形反向(提前制动)
+ *          和正向(出弯加速)两遍限制
+ *       3. 跟随：里程积分定位，检测到路口/T型事件时吸附到窗口内最近的同类地图事件，
+ *          速度目标取当前位置到前瞻距离内的最小值
+ */
+#include "track_map.h"
+
+Track_Map_t track_map;
+
+// 学习期间标记已有曲率样本的格 (闭合时补齐空格后清除)
+#define TRACK_BIN_FILLED        0x80U
+// 参与定位的事件
+#define TRACK_LOC_EVENTS        (LINE_EVT_INTERSECTION_ENTER | LINE_EVT_T_LEFT | LINE_EVT_T_RIGHT)
+
+/**
+ * @brief 赛道地图初始化函数
+ * @param track 赛道地图指针
+ * @note 需在速度规划器初始化之后调用 (速度曲线使用其限制)
+ */
+void Track_Init(Track_Map_t* track) {
+    if (track == NULL) return;
+
+    memset(track, 0, sizeof(*track));
+    track->mode = TRACK_IDLE;
+    Track_Load(track);
+}
+
+/**
+ * @brief 开始首圈学习
+ * @param track 赛道地图指针
+ */
+void Track_StartLearning(Track_Map_t* track) {
+    if (track == NULL) return;
+
+    memset(&track->map, 0, sizeof(track->map));
+    track->position = 0.0f;
+    track->start_yaw = Fusion_GetHeading(&yaw_fusion);
+    track->kappa_sum = 0.0f;
+    track->kappa_samples = 0;
+    track->learn_bin = 0;
+    track->lap_start_tick = 0;
+    track->mode = TRACK_LEARNING;
+}
+
+/**
+ * @brief 学习时结束当前格，写入平均曲率
+ */
+static void Track_CloseBin(Track_Map_t* track) {
+    if (track->kappa_samples == 0) return;
+
+    float k = track->kappa_sum / (float)track->kappa_samples * TRACK_KAPPA_SCALE;
+    if (k > 255.0f) k = 255.0f;
+
+    Track_Bin_t *bin = &track->map.bins[track->learn_bin];
+    bin->kappa = (uint8_t)(k + 0.5f);
+    bin->flags |= TRACK_BIN_FILLED;
+
+    track->kappa_sum = 0.0f;
+    track->kappa_samples = 0;
+}
+
+/**
+ * @brief 结束学习并以当前里程闭合一圈
+ * @param track 赛道地图指针
+ * @retval 1: 地图有效并开始跟随, 0: 里程过短，学习作废
+ */
+uint8_t Track_FinishLearning(Track_Map_t* track) {
+    if (track == NULL || track->mode != TRACK_LEARNING) return 0;
+
+    Track_CloseBin(track);
+
+    uint16_t count = (uint16_t)(track->position / TRACK_BIN_M + 0.5f);
+    if (count > TRACK_MAX_BINS) count = TRACK_MAX_BINS;
+    if (count < 2) {
+        track->map.bin_count = 0;
+        track->mode = TRACK_IDLE;
+        return 0;
+    }
+    track->map.bin_count = count;
+
+    // 空格(高速时跨格、编码器抖动)沿行驶方向沿用前一格曲率
+    uint8_t last = 0;
+    for (uint16_t i = 0; i < count; i++) {
+        if (track->map.bins[i].flags & TRACK_BIN_FILLED) last = track->map.bins[i].kappa;
+    }
+    for (uint16_t i = 0; i < count; i++) {
+        Track_Bin_t *bin = &track->map.bins[i];
+        if (bin->flags & TRACK_BIN_FILLED) {
+            last = bin->kappa;
+        } else {
+            bin->kappa = last;
+        }
+        bin->flags &= (uint8_t)~TRACK_BIN_FILLED;
+    }
+
+    // 起跑线(闭环路口)位于第0格，作为每圈的定位基准
+    track->map.bins[0].flags |= LINE_EVT_INTERSECTION_ENTER;
+
+    Track_ComputeSpeedProfile(track);
+    return Track_StartRunning(track);
+}
+
+/**
+ * @brief 从起跑线开始按地图跟随
+ * @param track 赛道地图指针
+ * @retval 1: 成功, 0: 无有效地图
+ */
+uint8_t Track_StartRunning(Track_Map_t* track) {
+    if (track == NULL || track->map.bin_count < 2) return 0;
+
+    track->position = 0.0f;
+    track->lap_count = 0;
+    track->lap_start_tick = 0;
+    track->loc_count = 0;
+    track->last_correction = 0.0f;
+    track->mode = TRACK_RUNNING;
+    return 1;
+}
+
+/**
+ * @brief 停止学习/跟随
+ * @param track 赛道地图指针
+ * @note 学习中停止时地图作废；跟随中停止时地图保留
+ */
+void Track_Stop(Track_Map_t* track) {
+    if (track == NULL) return;
+
+    if (track->mode == TRACK_LEARNING) {
+        track->map.bin_count = 0;
+    }
+    track->mode = (track->map.bin_count >= 2) ? TRACK_READY : TRACK_IDLE;
+}
+
+/**
+ * @brief 按当前速度规划限制计算速度曲线
+ * @param track 赛道地图指针
+ * @note 横向加速度、速度范围取自speed_planner，纵向取速度规划最大减速度(反向遍历)/加速度(正向遍历)×TRACK_ACCEL_MARGIN
+ */
+void Track_ComputeSpeedProfile(Track_Map_t* track) {
+    if (track == NULL) return;
+
+    uint16_t n = track->map.bin_count;
+    if (n < 2) return;
+
+    // 1. 曲率限速
+    for (uint16_t i = 0; i < n; i++) {
+        float k = (float)track->map.bins[i].kappa * (1.0f / TRACK_KAPPA_SCALE);
+        float v = speed_planner.v_max;
+        if (k * v * v > speed_planner.a_lat) {
+            v = sqrtf(speed_planner.a_lat / k);
+        }
+        if (v < speed_planner.v_min) v = speed_planner.v_min;
+        track->speed[i] = v;
+    }
+
+    // 2. 环形反向(减速度)/正向(加速度)限制，各遍历两圈保证跨起跑线收敛
+    float dv2_decel = 2.0f * speed_profile.max_decel * TRACK_ACCEL_MARGIN * TRACK_BIN_M;
+    float dv2 = 2.0f * speed_profile.max_accel * TRACK_ACCEL_MARGIN * TRACK_BIN_M;
+    for (uint32_t k = 0; k < 2U * n; k++) {
+        uint16_t i = (uint16_t)(n - 1 - (k % n));
+        uint16_t next = (uint16_t)((i + 1) % n);
+        float lim = sqrtf(track->speed[next] * track->speed[next] + dv2_decel);
+        if (track->speed[i] > lim) track->speed[i] = lim;
+    }
+    for (uint32_t k = 0; k < 2U * n; k++) {
+        uint16_t i = (uint16_t)(k % n);
+        uint16_t prev = (uint16_t)((i + n - 1) % n);
+        float lim = sqrtf(track->speed[prev] * track->speed[prev] + dv2);
+        if (track->speed[i] > lim) track->speed[i] = lim;
+    }
+}
+
+/**
+ * @brief 跟随时按事件校正里程位置
+ * @param events 本周期事件 (只取TRACK_LOC_EVENTS)
+ */
+static void Track_Localize(Track_Map_t* track, uint8_t events) {
+    uint16_t n = track->map.bin_count;
+    float lap_len = (float)n * TRACK_BIN_M;
+    float best = TRACK_LOC_WINDOW_M + 1.0f;
+    float best_delta = 0.0f;
+
+    for (uint16_t i = 0; i < n; i++) {
+        if (!(track->map.bins[i].flags & events)) continue;
+
+        // 环形距离，取[-L/2, L/2)
+        float delta = (float)i * TRACK_BIN_M - track->position;
+        if (delta >= 0.5f * lap_len) delta -= lap_len;
+        if (delta < -0.5f * lap_len) delta += lap_len;
+
+        if (fabsf(delta) < best) {
+            best = fabsf(delta);
+            best_delta = delta;
+        }
+    }
+
+    if (best > TRACK_LOC_WINDOW_M) return;
+
+    // 吸附跨越起跑线时同步圈数
+    float pos = track->position + best_delta;
+    if (pos >= lap_len) {
+        pos -= lap_len;
+        track->lap_count++;
+    } else if (pos < 0.0f) {
+        pos += lap_len;
+        if (track->lap_count > 0) track->lap_count--;
+    }
+    track->position = pos;
+    track->last_correction = best_delta;
+    track->loc_count++;
+}
+
+/**
+ * @brief 赛道地图周期更新函数
+ * @param track 赛道地图指针
+ * @param ds 本周期行驶距离(m)
+ * @param kappa 本周期车体曲率(1/m)
+ * @param events 本周期循线事件 (LINE_EVT_*)
+ * @param now_ms 当前时间(ms)
+ */
+void Track_Update(Track_Map_t* track, float ds, float kappa, uint8_t events, uint32_t now_ms) {
+    if (track == NULL) return;
+    if (track->mode != TRACK_LEARNING && track->mode != TRACK_RUNNING) return;
+
+    if (track->lap_start_tick == 0) track->lap_start_tick = now_ms;  // 起步时开始计时
+    track->position += ds;
+
+    if (track->mode == TRACK_LEARNING) {
+        // 闭环判定：再次进入路口、里程足够且航向回到起点
+        if ((events & LINE_EVT_INTERSECTION_ENTER) && track->position >= TRACK_MIN_LAP_M) {
+            float dyaw = fmodf(Fusion_GetHeading(&yaw_fusion) - track->start_yaw, 360.0f);  // 连续航向，一圈约±360度
+            if (dyaw > 180.0f) dyaw -= 360.0f;
+            if (dyaw < -180.0f) dyaw += 360.0f;
+            if (!IMU_IsDataReady() || fabsf(dyaw) <= TRACK_LAP_YAW_TOL_DEG) {
+                track->last_lap_ms = now_ms - track->lap_start_tick;
+                Track_FinishLearning(track);
+                track->lap_start_tick = now_ms;
+                return;
+            }
+        }
+
+        uint16_t bin = (uint16_t)(track->position / TRACK_BIN_M);
+        if (bin >= TRACK_MAX_BINS) {
+            Track_Stop(track);  // 超过地图容量，学习作废
+            return;
+        }
+        if (bin != track->learn_bin) {
+            Track_CloseBin(track);
+            track->learn_bin = bin;
+        }
+        track->kappa_sum += kappa;
+        track->kappa_samples++;
+        track->map.bins[bin].flags |= (events & TRACK_LOC_EVENTS);
+        return;
+    }
+
+    // 跟随：事件定位 + 圈数统计
+    if (events & TRACK_LOC_EVENTS) {
+        Track_Localize(track, events & TRACK_LOC_EVENTS);
+    }
+
+    float lap_len = (float)track->map.bin_count * TRACK_BIN_M;
+    if (track->position >= lap_len) {
+        track->position -= lap_len;
+        track->lap_count++;
+        track->last_lap_ms = now_ms - track->lap_start_tick;
+        track->lap_start_tick = now_ms;
+    }
+}
+
+/**
+ * @brief 获取当前位置前瞻范围内的速度目标
+ * @retval 当前格到TRACK_PREVIEW_M范围内速度曲线最小值(m/s)，速度规划的跟踪滞后由前瞻补偿
+ */
+float Track_GetSpeed(const Track_Map_t* track) {
+    if (track == NULL || track->map.bin_count < 2) return speed_planner.v_min;
+
+    uint16_t n = track->map.bin_count;
+    uint16_t bin = (uint16_t)(track->position / TRACK_BIN_M);
+    uint16_t preview = (uint16_t)(TRACK_PREVIEW_M / TRACK_BIN_M + 0.999f);
+    if (bin >= n) bin = n - 1;
+
+    float v = track->speed[bin];
+    for (uint16_t k = 1; k <= preview; k++) {
+        float s = track->speed[(bin + k) % n];
+        if (s < v) v = s;
+    }
+    return v;
+}
+
+/**
+ * @brief 保存地图到Flash (擦写期间CPU停顿约1s，电机运行时不要调用)
+ * @retval 1: 成功, 0: 失败或无有效地图
+ */
+uint8_t Track_Save(const Track_Map_t* track) {
+    if (track == NULL || track->map.bin_count < 2) return 0;
+
+    return Flash_SaveRecord(FLASH_REGION_TRACK, TRACK_MAGIC, &track->map, sizeof(track->map));
+}
+
+/**
+ * @brief 从Flash加载地图并计算速度曲线
+ * @retval 1: 已加载, 0: 无有效记录
+ */
+uint8_t Track_Load(Track_Map_t* track) {
+    if (track == NULL) return 0;
+
+    if (!Flash_LoadRecord(FLASH_REGION_TRACK, TRACK_MAGIC, &track->map, sizeof(track->map))
+        || track->map.bin_count < 2 || track->map.bin_count > TRACK_MAX_BINS) {
+        track->map.bin_count = 0;
+        return 0;
+    }
+
+    Track_ComputeSpeedProfile(track);
+    track->mode = TRACK_READY;
+    return 1;
+}
+
+/**
+ * @brief 获取模式名称
+ */
+const char* Track_GetModeName(Track_Mode_t mode) {
+    static const char* names[] = {"未学习", "学习中", "地图就绪", "跟随中"};
+
+    if (mode > TRACK_RUNNING) return "未知";
+    return names[mode];
+}
@@ -0,0 +1,106 @@
+/**
+ * @file track_map.h
+ * @brief 赛道学习模块头文件 - 首圈按里程记录曲率与路口事件，后续圈定位并按预计算速度曲线行驶
+ */
+#ifndef TRACK_MAP_H
+#define TRACK_MAP_H
+
+#include "mydefine.h"
+
+// 赛道地图配置参数已迁移到mydefine.h统一管理
+
+// 赛道学习模式
+typedef enum {
+    TRACK_IDLE = 0,          // 未学习/已停止
+    TRACK_LEARNING,          // 首圈学习中
+    TRACK_READY,             // 地图可用，未跟随
+    TRACK_RUNNING            // 按地图定位并跟随速度曲线
+} Track_Mode_t;
+
+// 地图格 (每TRACK_BIN_M一格)
+typedef struct {
+    uint8_t kappa;           // 曲率 × TRACK_KAPPA_SCALE (1/m)，饱和255
+    uint8_t flags;           // 该格检测到的循线事件 (LINE_EVT_*)
+} Track_Bin_t;
+
+// 地图数据 (Flash持久化部分)
+typedef struct {
+    uint16_t bin_count;      // 一圈格数 (圈长 = bin_count × TRACK_BIN_M)
+    uint16_t reserved;       // 保留(对齐)
+    Track_Bin_t bins[TRACK_MAX_BINS];
+} Track_MapData_t;
+
+// 赛道学习数据结构
+typedef struct {
+    Track_Mode_t mode;                 // 当前模式
+    Track_MapData_t map;               // 地图数据
+    float speed[TRACK_MAX_BINS];       // 预计算速度曲线(m/s)
+
+    float position;                    // 本圈里程位置(m)
+    float start_yaw;                   // 学习起点融合航向(度)，用于闭环判定
+    float kappa_sum;                   // 当前格曲率累加 (学习时求平均)
+    uint16_t kappa_samples;            // 当前格曲率样本数
+    uint16_t learn_bin;                // 学习中当前格
+
+    uint32_t lap_count;                // 跟随圈数
+    uint32_t lap_start_tick;           // 本圈开始时间(ms)
+    uint32_t last_lap_ms;              // 上一圈用时(ms)
+    uint32_t loc_count;                // 事件定位校正次数
+    float last_correction;             // 最近一次定位校正量(m)
+} Track_Map_t;
+
+// 全局赛道地图
+extern Track_Map_t track_map;
+
+/**
+ * @brief 赛道地图初始化函数 (尝试从Flash加载地图)
+ */
+void Track_Init(Track_Map_t* track);
+
+/**
+ * @brief 开始首圈学习 (小车置于起跑线)
+ */
+void Track_StartLearning(Track_Map_t* track);
+
+/**
+ * @brief 结束学习并以当前里程闭合一圈 (手动闭环)
+ */
+uint8_t Track_FinishLearning(Track_Map_t* track);
+
+/**
+ * @brief 从起跑线开始按地图跟随
+ */
+uint8_t Track_StartRunning(Track_Map_t* track);
+
+/**
+ * @brief 停止学习/跟随
+ */
+void Track_Stop(Track_Map_t* track);
+
+/**
+ * @brief 按当前速度规划限制重新计算速度曲线
+ */
+void Track_ComputeSpeedProfile(Track_Map_t* track);
+
+/**
+ * @brief 赛道地图周期更新函数 - 里程积分、学习记录、事件定位
+ */
+void Track_Update(Track_Map_t* track, float ds, float kappa, uint8_t events, uint32_t now_ms);
+
+/**
+ * @brief 获取当前位置前瞻范围内的速度目标
+ */
+float Track_GetSpeed(const Track_Map_t* track);
+
+/**
+ * @brief 地图Flash保存/加载
+ */
+uint8_t Track_Save(const Track_Map_t* track);
+uint8_t Track_Load(Track_Map_t* track);
+
+/**
+ * @brief 获取模式名称
+ */
+const char* Track_GetModeName(Track_Mode_t mode);
+
+#endif
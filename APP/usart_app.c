@@ -113,8 +113,19 @@ void handle_PWM_check_command() {
     my_printf(&huart2,"右轮PWM:%d\r\n",PWM_right_value);
 }
 
-// PWM参数化指令处理函数 - 支持pwm [left|right] [value]格式
+// PWM参数化指令处理函数 - 支持pwm [left|right] [value] / pwm bench [n]格式
 void handle_PWM_command_with_params(char** params, int param_count) {
+    // 电机输出耗时对比: pwm bench [iterations]
+    if (param_count >= 1 && strcmp(params[0], "bench") == 0) {
+        uint32_t iterations = (param_count >= 2) ? (uint32_t)atoi(params[1]) : 1000;
+        if (iterations == 0 || iterations > 100000) {
+            my_printf(&huart2,"错误：迭代次数范围为 1 到 100000\r\n");
+            return;
+        }
+        Motor_Bench(iterations);
+        return;
+    }
+
     if (param_count == 0) {
         // 无参数时显示当前PWM状态
         my_printf(&huart2,"左轮PWM:%d\r\n",PWM_left_value);
@@ -174,6 +185,10 @@ void handle_MOTOR_TEST_command() {
     my_printf(&huart2,"请观察电机运行状态\r\n");
 }
 void handle_START_command(void) {
+    if (Shape_IsCharacterizing(&motor_shape)) {
+        my_printf(&huart2,"错误：电机特性标定中，请先stop\r\n");
+        return;
+    }
     Motor_Start();  // 使用新的Motor_Start函数
     my_printf(&huart2,"Motor started successfully\r\n");
 }
@@ -216,7 +231,9 @@ void handle_SHOW_IMU_command(void) {
     my_printf(&huart2,"Roll:  %.1f°\r\n", imu_data.roll);
     my_printf(&huart2,"Pitch: %.1f°\r\n", imu_data.pitch);
     my_printf(&huart2,"Yaw:   %.1f°\r\n", imu_data.yaw);
-    my_printf(&huart2,"更新时间: %lu ms\r\n", imu_data.last_update_time);
+    my_printf(&huart2,"角速度: %.2f, %.2f, %.2f °/s\r\n", imu_data.gx, imu_data.gy, imu_data.gz);
+    my_printf(&huart2,"加速度: %.2f, %.2f, %.2f m/s²\r\n", imu_data.ax, imu_data.ay, imu_data.az);
+    my_printf(&huart2,"更新时间: %lu ms (采样序号 %lu)\r\n", imu_data.last_update_time, imu_data.sample_seq);
 
     // 显示通信状态
     if (imu_data.comm_error_count > 0) {
@@ -243,6 +260,8 @@ void handle_SENSOR_command(void) {
     my_printf(&huart2,"--- ADC电压 ---\r\n");
     my_printf(&huart2,"Voltage:%.2fV  \r\n",voltage);
     my_printf(&huart2,"ADC:%u\r\n",adc_val);
+    my_printf(&huart2,"电池: %.2fV (滤波 %.2fV), PWM补偿系数: %.3f\r\n",
+              battery.vbat, battery.vbat_filtered, battery.factor);
 
     // 显示IMU数据
     my_printf(&huart2,"--- IMU姿态 ---\r\n");
@@ -254,6 +273,8 @@ void handle_SENSOR_command(void) {
         my_printf(&huart2,"Roll:  %.1f°\r\n", imu_data.roll);
         my_printf(&huart2,"Pitch: %.1f°\r\n", imu_data.pitch);
         my_printf(&huart2,"Yaw:   %.1f°\r\n", imu_data.yaw);
+        my_printf(&huart2,"角速度: %.2f, %.2f, %.2f °/s\r\n", imu_data.gx, imu_data.gy, imu_data.gz);
+        my_printf(&huart2,"加速度: %.2f, %.2f, %.2f m/s²\r\n", imu_data.ax, imu_data.ay, imu_data.az);
         my_printf(&huart2,"更新时间: %lu ms\r\n", imu_data.last_update_time);
         if (imu_data.comm_error_count > 0) {
             my_printf(&huart2,"通信错误次数: %d\r\n", imu_data.comm_error_count);
@@ -261,6 +282,15 @@ void handle_SENSOR_command(void) {
             my_printf(&huart2,"通信状态: 正常\r\n");
         }
     }
+
+    // 显示各传感器样本年龄 (采集时刻到当前的时间)
+    uint32_t now_us = Perf_GetMicros();
+    my_printf(&huart2,"--- 样本年龄 (%s) ---\r\n", SAMPLE_ALIGN_ENABLE ? "控制时刻对齐已使能" : "未对齐");
+    my_printf(&huart2,"IMU: %.1f ms, Gary: %.1f ms\r\n",
+              Sample_AgeUs(imu_data.sample_us, now_us) * 0.001f, Sample_AgeUs(gary_data.sample_us, now_us) * 0.001f);
+    my_printf(&huart2,"编码器A: %.1f ms, 编码器B: %.1f ms (滑动平均窗口中点)\r\n",
+              Sample_AgeUs(encoder_data_A.speed_time_us, now_us) * 0.001f,
+              Sample_AgeUs(encoder_data_B.speed_time_us, now_us) * 0.001f);
     my_printf(&huart2,"==================\r\n");
 }
 
@@ -375,9 +405,18 @@ void handle_GARY_command(void) {
         my_printf(&huart2,"循线状态: 未知(%u)\r\n", gary_data.line_state);
     }
 
-    my_printf(&huart2,"位置偏差: %.1f (范围: -4.0到+4.0)\r\n", gary_data.line_error);
+    my_printf(&huart2,"位置偏差: %.2f (范围: -4.0到+4.0)\r\n", gary_data.line_error);
+    my_printf(&huart2,"偏差来源: %s (对比度: %.2f)\r\n",
+              (gary_data.line_source == GARY_SOURCE_ANALOG) ? "模拟量质心" : "数字位图", gary_data.line_contrast);
     my_printf(&huart2,"线宽检测: %u个传感器\r\n", gary_data.line_width);
-    my_printf(&huart2,"线检测: %s\r\n", (gary_data.line_state != LINE_LOST) ? "有线" : "无线");
+    my_printf(&huart2,"线检测: %s\r\n", Gary_IsLineFound() ? "有线" : "无线");
+    my_printf(&huart2,"稳定状态: %s (置信度: %.0f%%, 保持: %u帧)\r\n", state_names[line_classifier.stable],
+              line_classifier.confidence * 100.0f, line_classifier.dwell);
+    my_printf(&huart2,"事件计数:");
+    for(uint8_t i = 0; i < LINE_EVT_NUM; i++) {
+        my_printf(&huart2," %s=%lu", Classifier_GetEventName(i), (unsigned long)line_classifier.event_count[i]);
+    }
+    my_printf(&huart2,"\r\n");
 
     // 显示详细状态部分
     my_printf(&huart2,"--- 系统状态 ---\r\n");
@@ -480,6 +519,12 @@ void uart_command(uint8_t *buffer,uint16_t Size) {
     else if (strcmp(cmd, "stop") == 0) {
         handle_STOP_command();
     }
+    else if (strcmp(cmd, "heading") == 0) {
+        handle_HEADING_command_with_params(params, param_count);
+    }
+    else if (strcmp(cmd, "imu") == 0) {
+        handle_IMU_command_with_params(params, param_count);
+    }
     else if (strcmp(cmd, "sensor") == 0) {
         handle_SENSOR_command();
     }
@@ -497,10 +542,22 @@ void uart_command(uint8_t *buffer,uint16_t Size) {
                 handle_GARY_PING_command();
             } else if (strcmp(params[0], "reinit") == 0) {
                 handle_GARY_REINIT_command();
+            } else if (strcmp(params[0], "cal") == 0) {
+                handle_GARY_CAL_command_with_params(NULL, 0);
+            } else if (strcmp(params[0], "stats") == 0) {
+                handle_GARY_STATS_command_with_params(NULL, 0);
+            } else if (strcmp(params[0], "acq") == 0) {
+                handle_GARY_ACQ_command_with_params(NULL, 0);
             } else {
                 my_printf(&huart2,"错误：无效Gary参数 '%s'\r\n", params[0]);
-                my_printf(&huart2,"支持的参数: ping, reinit\r\n");
+                my_printf(&huart2,"支持的参数: ping, reinit, cal, stats, acq\r\n");
             }
+        } else if (param_count == 2 && strcmp(params[0], "cal") == 0) {
+            handle_GARY_CAL_command_with_params(&params[1], 1);
+        } else if (param_count == 2 && strcmp(params[0], "stats") == 0) {
+            handle_GARY_STATS_command_with_params(&params[1], 1);
+        } else if (param_count == 2 && strcmp(params[0], "acq") == 0) {
+            handle_GARY_ACQ_command_with_params(&params[1], 1);
         } else {
             my_printf(&huart2,"错误：Gary参数过多\r\n");
         }
@@ -514,6 +571,30 @@ void uart_command(uint8_t *buffer,uint16_t Size) {
     else if (strcmp(cmd, "pid") == 0) {
         handle_PID_command_with_params(params, param_count);
     }
+    else if (strcmp(cmd, "profile") == 0) {
+        handle_PROFILE_command_with_params(params, param_count);
+    }
+    else if (strcmp(cmd, "bench") == 0) {
+        handle_BENCH_command_with_params(params, param_count);
+    }
+    else if (strcmp(cmd, "recover") == 0) {
+        handle_RECOVER_command_with_params(params, param_count);
+    }
+    else if (strcmp(cmd, "planner") == 0) {
+        handle_PLANNER_command_with_params(params, param_count);
+    }
+    else if (strcmp(cmd, "brake") == 0) {
+        handle_BRAKE_command_with_params(params, param_count);
+    }
+    else if (strcmp(cmd, "battery") == 0) {
+        handle_BATTERY_command_with_params(params, param_count);
+    }
+    else if (strcmp(cmd, "motor") == 0) {
+        handle_MOTOR_command_with_params(params, param_count);
+    }
+    else if (strcmp(cmd, "track") == 0) {
+        handle_TRACK_command_with_params(params, param_count);
+    }
     else if (strcmp(cmd, "help") == 0) {
         handle_HELP_command();
     }
@@ -566,15 +647,32 @@ void handle_HELP_command(void) {
     my_printf(&huart2,"  示例: pwm          (查看状态)\r\n");
     my_printf(&huart2,"        pwm left 500 (设置左轮PWM)\r\n");
     my_printf(&huart2,"        pwm right -300 (设置右轮PWM)\r\n");
+    my_printf(&huart2,"        pwm bench [n]  (电机输出耗时对比，需停车)\r\n");
+    my_printf(&huart2,"battery [on|off|cal <V>] - 电池电压补偿与低压降额\r\n");
+    my_printf(&huart2,"motor [characterize|curve|reset] - 电机死区补偿与线性化查找表\r\n");
+    my_printf(&huart2,"  示例: motor characterize (车轮架空，扫描PWM-轮速特性自动建表)\r\n");
+    my_printf(&huart2,"        motor shape off  (关闭整形)\r\n");
+    my_printf(&huart2,"        motor deadband 80 90 (手动设置左右死区)\r\n");
     my_printf(&huart2,"start                    - 启动电机\r\n");
     my_printf(&huart2,"stop                     - 停止电机\r\n");
     my_printf(&huart2,"speed <value>            - 设置基础速度(m/s)\r\n");
     my_printf(&huart2,"  示例: speed 0.5        (设置为0.5m/s)\r\n");
     my_printf(&huart2,"        speed            (查看当前速度)\r\n");
+    my_printf(&huart2,"profile [accel] [jerk] [decel] - 速度规划加速度/加加速度/减速度限制\r\n");
+    my_printf(&huart2,"  示例: profile 3 30     (3m/s², 30m/s³)\r\n");
+    my_printf(&huart2,"        profile 3 30 5   (减速度5m/s²，依赖短路制动)\r\n");
+    my_printf(&huart2,"brake [on|off]           - 减速短路制动状态与统计\r\n");
+    my_printf(&huart2,"        profile          (查看规划状态)\r\n");
+    my_printf(&huart2,"recover [reset]          - 丢线恢复状态与找线耗时统计\r\n");
+    my_printf(&huart2,"planner [on|off|<a_lat> <v_max>] - 曲率自适应速度规划\r\n");
+    my_printf(&huart2,"  示例: planner 2 1.0    (横向加速度2m/s², 直道1.0m/s)\r\n");
+    my_printf(&huart2,"track [learn|stop|run|dump|save|load] - 赛道学习与地图速度曲线\r\n");
     my_printf(&huart2,"pid <controller> <kp> <ki> <kd> - 设置PID参数\r\n");
     my_printf(&huart2,"  示例: pid left 200 20 25 (设置左轮PID)\r\n");
     my_printf(&huart2,"        pid all 180 16 18  (设置所有速度环)\r\n");
     my_printf(&huart2,"        pid              (查看所有PID参数)\r\n");
+    my_printf(&huart2,"        pid bench [n]    (速度环计算耗时对比)\r\n");
+    my_printf(&huart2,"bench [step|ramp|disturb|line] - 仿真对象闭环基准测试(CSV)\r\n");
 
     my_printf(&huart2,"\r\n=== 传感器数据 (2个指令) ===\r\n");
     my_printf(&huart2,"sensor                   - 显示所有传感器数据\r\n");
@@ -582,12 +680,20 @@ void handle_HELP_command(void) {
     my_printf(&huart2,"encoder [debug|cal]      - 编码器功能\r\n");
     my_printf(&huart2,"  示例: encoder debug    (速度+计数器调试)\r\n");
     my_printf(&huart2,"        encoder cal      (编码器校准)\r\n");
+    my_printf(&huart2,"heading [zero|fc <hz>]   - 连续航向、陀螺仪零偏、角速度融合与打滑统计\r\n");
+    my_printf(&huart2,"imu [reset]              - IMU传输方式与串口流解析统计\r\n");
+    my_printf(&huart2,"imu config [apply|rate <hz>|bw <hz>|axis <6|9>] - IMU输出速率/带宽/算法配置档\r\n");
 
     my_printf(&huart2,"\r\n=== Gary灰度传感器 (3个指令) ===\r\n");
     my_printf(&huart2,"gary                     - 显示完整传感器信息\r\n");
     my_printf(&huart2,"  (包含: 数据+循线状态+系统状态)\r\n");
     my_printf(&huart2,"gary ping                - 检测传感器连接\r\n");
     my_printf(&huart2,"gary reinit              - 重新初始化传感器\r\n");
+    my_printf(&huart2,"gary cal [start|stop|white|black|save] - 灰度标定\r\n");
+    my_printf(&huart2,"  示例: gary cal start   (开始扫描，传感器扫过黑线和白场)\r\n");
+    my_printf(&huart2,"        gary cal stop    (结束扫描，生成查找表并保存)\r\n");
+    my_printf(&huart2,"gary stats [on|off|reset] - 自适应阈值跟踪状态\r\n");
+    my_printf(&huart2,"gary acq [on|off|reset]  - 自适应采集(数字/模拟读取)统计\r\n");
 
     my_printf(&huart2,"\r\n=== 系统管理 (3个指令) ===\r\n");
     my_printf(&huart2,"system [perf|reset|diag] - 系统功能\r\n");
@@ -614,7 +720,8 @@ void handle_HELP_command(void) {
 void handle_GARY_PING_command(void) {
     my_printf(&huart2,"=== Gary传感器连接检测 ===\r\n");
 
-    // 调用底层Ping函数检测连接
+    // 调用底层Ping函数检测连接 (先等待进行中的DMA采样结束)
+    Gary_WaitBusIdle();
     if(Ping() == 0) {
         my_printf(&huart2,"Gary传感器连接正常\r\n");
         my_printf(&huart2,"I2C地址: 0x%02X\r\n", GARY_I2C_ADDR);
@@ -625,6 +732,7 @@ void handle_GARY_PING_command(void) {
     }
 
     my_printf(&huart2,"通信错误计数: %u\r\n", gary_data.comm_error_count);
+    my_printf(&huart2,"采样序号: %lu\r\n", (unsigned long)gary_data.sample_seq);
 }
 
 /**
@@ -719,9 +827,18 @@ void handle_GARY_LINE_command(void) {
         my_printf(&huart2,"循线状态: 未知(%u)\r\n", gary_data.line_state);
     }
 
-    my_printf(&huart2,"位置偏差: %.1f (范围: -4.0到+4.0)\r\n", gary_data.line_error);
+    my_printf(&huart2,"位置偏差: %.2f (范围: -4.0到+4.0)\r\n", gary_data.line_error);
+    my_printf(&huart2,"偏差来源: %s (对比度: %.2f)\r\n",
+              (gary_data.line_source == GARY_SOURCE_ANALOG) ? "模拟量质心" : "数字位图", gary_data.line_contrast);
     my_printf(&huart2,"线宽检测: %u个传感器\r\n", gary_data.line_width);
-    my_printf(&huart2,"线检测: %s\r\n", (gary_data.line_state != LINE_LOST) ? "有线" : "无线");
+    my_printf(&huart2,"线检测: %s\r\n", Gary_IsLineFound() ? "有线" : "无线");
+    my_printf(&huart2,"稳定状态: %s (置信度: %.0f%%, 保持: %u帧)\r\n", state_names[line_classifier.stable],
+              line_classifier.confidence * 100.0f, line_classifier.dwell);
+    my_printf(&huart2,"事件计数:");
+    for(uint8_t i = 0; i < LINE_EVT_NUM; i++) {
+        my_printf(&huart2," %s=%lu", Classifier_GetEventName(i), (unsigned long)line_classifier.event_count[i]);
+    }
+    my_printf(&huart2,"\r\n");
 }
 
 /**
@@ -794,21 +911,17 @@ void handle_SPEED_command_with_params(char** params, int param_count) {
         float old_speed = basic_speed;
         basic_speed = new_speed;
         
-        // 重新设置PID目标值
-        pid_set_target(&PID_left_speed, basic_speed);
-        pid_set_target(&PID_right_speed, basic_speed);
-        
-        // 重置PID积分项，避免突变影响
-        PID_reset_all();
+        // 新速度作为速度规划目标，由pid_task按加速度限制过渡 (不清除积分项)
+        Profile_SetTarget(&speed_profile, basic_speed);
         
         my_printf(&huart2,"基础速度已更新:\r\n");
         my_printf(&huart2,"  旧值: %.3f m/s\r\n", old_speed);
         my_printf(&huart2,"  新值: %.3f m/s\r\n", basic_speed);
-        my_printf(&huart2,"PID目标值已同步更新\r\n");
+        my_printf(&huart2,"速度规划目标已同步更新\r\n");
         
         // 如果电机正在运行，提示用户
         if (enable) {
-            my_printf(&huart2,"注意：电机正在运行，新速度将立即生效\r\n");
+            my_printf(&huart2,"注意：电机正在运行，将按 %.1fm/s² 加速度平滑过渡\r\n", speed_profile.max_accel);
         } else {
             my_printf(&huart2,"提示：电机未启动，使用'start'命令启动电机\r\n");
         }
@@ -839,6 +952,18 @@ void handle_PID_command_with_params(char** params, int param_count) {
         my_printf(&huart2,"控制器类型: left, right, line, angle, all\r\n");
         my_printf(&huart2,"示例: pid left 200 20 25\r\n");
         my_printf(&huart2,"      pid all 180 16 18 (设置所有速度环)\r\n");
+        my_printf(&huart2,"      pid bench 1000    (速度环计算耗时对比)\r\n");
+        return;
+    }
+
+    // 速度环计算耗时对比: pid bench [iterations]
+    if (param_count >= 1 && strcmp(params[0], "bench") == 0) {
+        uint32_t iterations = (param_count >= 2) ? (uint32_t)atoi(params[1]) : 1000;
+        if (iterations == 0 || iterations > 100000) {
+            my_printf(&huart2,"错误：迭代次数范围为 1 到 100000\r\n");
+            return;
+        }
+        PID_Bench(iterations);
         return;
     }
 
@@ -946,7 +1071,7 @@ void handle_PID_command_with_params(char** params, int param_count) {
 
         // 如果电机正在运行，提示用户
         if (enable) {
-            my_printf(&huart2,"注意：电机正在运行，新PID参数将立即生效\r\n");
+            my_printf(&huart2,"注意：电机正在运行，新PID参数将在下一控制周期无扰切换\r\n");
         } else {
             my_printf(&huart2,"提示：电机未启动，使用'start'命令启动电机\r\n");
         }
@@ -960,4 +1085,683 @@ void handle_PID_command_with_params(char** params, int param_count) {
     my_printf(&huart2,"示例: pid left 200 20 25\r\n");
 }
 
+// 速度规划参数命令处理函数 - 支持profile [accel] [jerk] [decel]格式
+void handle_PROFILE_command_with_params(char** params, int param_count) {
+    if (param_count == 0) {
+        // 无参数时显示速度规划状态
+        my_printf(&huart2,"=== 速度规划状态 ===\r\n");
+        my_printf(&huart2,"最大加速度: %.2f m/s², 最大减速度: %.2f m/s²\r\n", speed_profile.max_accel, speed_profile.max_decel);
+        my_printf(&huart2,"最大加加速度: %.2f m/s³\r\n", speed_profile.max_jerk);
+        my_printf(&huart2,"目标速度: %.3f m/s\r\n", speed_profile.target);
+        my_printf(&huart2,"当前输出: %.3f m/s (加速度 %.2f m/s²)\r\n", speed_profile.v, speed_profile.a);
+        my_printf(&huart2,"状态: %s\r\n", speed_profile.active ? "过渡中" : "已到达");
+        return;
+    }
+
+    if (param_count == 2 || param_count == 3) {
+        float accel = atof(params[0]);
+        float jerk = atof(params[1]);
+        float decel = (param_count == 3) ? atof(params[2]) : speed_profile.max_decel;
+
+        // 参数范围验证
+        if (accel <= 0.0f || accel > 20.0f || jerk <= 0.0f || jerk > 500.0f || decel <= 0.0f || decel > 20.0f) {
+            my_printf(&huart2,"错误：加/减速度范围 (0, 20] m/s²，加加速度范围 (0, 500] m/s³\r\n");
+            return;
+        }
+
+        Profile_SetLimits(&speed_profile, accel, jerk);
+        Profile_SetDecel(&speed_profile, decel);
+        my_printf(&huart2,"速度规划限制已更新: %.2f m/s², %.2f m/s³, 减速 %.2f m/s²\r\n", accel, jerk, decel);
+        my_printf(&huart2,"加速度建立时间: %.0f ms\r\n", accel / jerk * 1000.0f);
+        return;
+    }
+
+    my_printf(&huart2,"错误：参数数量错误，格式: profile [accel] [jerk] [decel]\r\n");
+    my_printf(&huart2,"示例: profile 3 30 (最大加速度3m/s²，加加速度30m/s³)\r\n");
+}
+
+// 闭环基准测试命令处理函数 - 支持bench [step|ramp|disturb|line]格式
+void handle_BENCH_command_with_params(char** params, int param_count) {
+    // 仿真在串口任务中阻塞运行，期间控制环不更新
+    if (enable) {
+        my_printf(&huart2,"错误：电机运行中，请先使用'stop'停止电机\r\n");
+        return;
+    }
+
+    if (param_count == 0) {
+        Bench_Report(-1); // 无参数时运行全部场景
+        return;
+    }
+
+    if (param_count == 1) {
+        for (int s = 0; s < BENCH_NUM; s++) {
+            if (strcmp(params[0], Bench_GetName((Bench_Scenario_t)s)) == 0) {
+                Bench_Report(s);
+                return;
+            }
+        }
+        my_printf(&huart2,"错误：无效场景 '%s'\r\n", params[0]);
+        my_printf(&huart2,"支持的场景: step, ramp, disturb, line\r\n");
+        return;
+    }
+
+    my_printf(&huart2,"错误：参数过多，格式: bench [step|ramp|disturb|line]\r\n");
+}
+
+// 丢线恢复命令处理函数 - 支持recover [reset]格式
+void handle_RECOVER_command_with_params(char** params, int param_count) {
+    if (param_count == 0) {
+        my_printf(&huart2,"=== 丢线恢复状态 ===\r\n");
+        my_printf(&huart2,"当前状态: %s\r\n", Recovery_GetStateName(line_recovery.state));
+        my_printf(&huart2,"最后偏差: %.2f, 最后角速度: %.2f rad/s\r\n", line_recovery.last_error, line_recovery.last_omega);
+        my_printf(&huart2,"丢线次数: %lu, 找回次数: %lu, 搜索失败: %lu\r\n",
+                  (unsigned long)line_recovery.lost_count, (unsigned long)line_recovery.reacquire_count,
+                  (unsigned long)line_recovery.fail_count);
+        if (line_recovery.reacquire_count > 0) {
+            my_printf(&huart2,"找线耗时: 最近 %lu ms, 平均 %lu ms, 最长 %lu ms\r\n",
+                      (unsigned long)line_recovery.last_reacquire_ms,
+                      (unsigned long)(line_recovery.total_reacquire_ms / line_recovery.reacquire_count),
+                      (unsigned long)line_recovery.max_reacquire_ms);
+        }
+        my_printf(&huart2,"参数: 确认%dms, 转向%dms(速度x%.2f), 搜索%dms\r\n",
+                  LINE_LOST_CONFIRM_MS, LINE_RECOVER_STEER_MS, LINE_RECOVER_SPEED_SCALE, LINE_SEARCH_TIMEOUT_MS);
+        return;
+    }
+
+    if (param_count == 1 && strcmp(params[0], "reset") == 0) {
+        Recovery_ClearStats(&line_recovery);
+        my_printf(&huart2,"丢线恢复统计已清除\r\n");
+        return;
+    }
+
+    my_printf(&huart2,"错误：格式: recover [reset]\r\n");
+}
+
+// Gary自适应阈值命令处理函数 - 支持gary stats [on|off|reset]格式
+void handle_GARY_STATS_command_with_params(char** params, int param_count) {
+    if (param_count == 0) {
+        const Gary_Calibration_t *cal = Gary_GetCalibration();
+
+        my_printf(&huart2,"=== 灰度自适应阈值 ===\r\n");
+        my_printf(&huart2,"状态: %s\r\n", gary_threshold.enabled ? "已使能" : "未使能(标定查找表+固定阈值)");
+        my_printf(&huart2,"通道 黑均值 白均值 阈值 漂移 有效 黑样本 白样本\r\n");
+        for (uint8_t i = 0; i < 8; i++) {
+            int16_t ref = (int16_t)(((uint16_t)cal->black[i] + cal->white[i] + 1) / 2);
+            my_printf(&huart2," %u   %5.1f  %5.1f  %3u  %+4d  %s  %lu %lu\r\n", i,
+                      gary_threshold.black[i], gary_threshold.white[i], gary_threshold.threshold[i],
+                      (int)((int16_t)gary_threshold.threshold[i] - ref), gary_threshold.valid[i] ? "是" : "否",
+                      gary_threshold.black_count[i], gary_threshold.white_count[i]);
+        }
+        my_printf(&huart2,"查找表重建: %lu次, 漂移限幅: %lu次 (限幅±%.0f)\r\n",
+                  gary_threshold.lut_rebuilds, gary_threshold.clamp_count, GARY_ADAPT_MAX_DRIFT);
+        return;
+    }
+
+    if (param_count == 1) {
+        if (strcmp(params[0], "on") == 0 || strcmp(params[0], "off") == 0) {
+            uint8_t on = (strcmp(params[0], "on") == 0);
+            Gary_SetAdaptiveThreshold(on);
+            my_printf(&huart2,"自适应阈值已%s\r\n", on ? "使能" : "禁用，恢复标定查找表");
+            return;
+        }
+        if (strcmp(params[0], "reset") == 0) {
+            Gary_SetAdaptiveThreshold(gary_threshold.enabled);
+            my_printf(&huart2,"自适应阈值已按标定值重置\r\n");
+            return;
+        }
+    }
+
+    my_printf(&huart2,"错误：格式: gary stats [on|off|reset]\r\n");
+}
+
+// Gary自适应采集命令处理函数 - 支持gary acq [on|off|reset]格式
+void handle_GARY_ACQ_command_with_params(char** params, int param_count) {
+    const Gary_Acq_t *acq = Gary_GetAcqStats();
+
+    if (param_count == 0) {
+        uint32_t total = acq->analog_count + acq->digital_count;
+        uint32_t elapsed_ms = HAL_GetTick() - acq->start_tick;
+        // 单次存储器读事务: 写地址+寄存器+读地址+N字节数据，每字节9位
+        float bus_us = ((float)acq->analog_count * (3 + 8) + (float)acq->digital_count * (3 + 1)) * 9.0f * GARY_I2C_BIT_US;
+
+        my_printf(&huart2,"=== 灰度自适应采集 ===\r\n");
+        my_printf(&huart2,"状态: %s\r\n", acq->adaptive ? "已使能" : "未使能(始终读取模拟量)");
+        my_printf(&huart2,"模拟量读取: %lu次 (强制刷新 %lu次)\r\n", acq->analog_count, acq->forced_count);
+        my_printf(&huart2,"数字读取: %lu次 (%.1f%%)\r\n", acq->digital_count,
+                  total ? 100.0f * acq->digital_count / total : 0.0f);
+        my_printf(&huart2,"升级为模拟量: %lu次, 位图不一致: %lu次\r\n", acq->escalate_count, acq->mismatch_count);
+        if (elapsed_ms > 0) {
+            my_printf(&huart2,"I2C3总线占用估计: %.1f%% (全模拟量 %.1f%%), 统计 %lu ms\r\n",
+                      bus_us / (10.0f * elapsed_ms),
+                      (float)total * (3 + 8) * 9.0f * GARY_I2C_BIT_US / (10.0f * elapsed_ms), elapsed_ms);
+        }
+        return;
+    }
+
+    if (param_count == 1) {
+        if (strcmp(params[0], "on") == 0 || strcmp(params[0], "off") == 0) {
+            uint8_t on = (strcmp(params[0], "on") == 0);
+            Gary_SetAdaptiveAcq(on);
+            my_printf(&huart2,"自适应采集已%s\r\n", on ? "使能" : "禁用，始终读取模拟量");
+            return;
+        }
+        if (strcmp(params[0], "reset") == 0) {
+            Gary_ResetAcqStats();
+            my_printf(&huart2,"采集统计已清除\r\n");
+            return;
+        }
+    }
+
+    my_printf(&huart2,"错误：格式: gary acq [on|off|reset]\r\n");
+}
+
+// 航向命令处理函数 - 支持heading [zero|fc <hz>]格式
+void handle_HEADING_command_with_params(char** params, int param_count) {
+    if (param_count == 0) {
+        my_printf(&huart2,"=== 连续航向 ===\r\n");
+        if (!IMU_IsDataReady()) {
+            my_printf(&huart2,"IMU数据未就绪\r\n");
+            return;
+        }
+        my_printf(&huart2,"航向: %.2f° (圈数 %ld, IMU偏航角 %.2f°)\r\n",
+                  heading_data.heading, (long)heading_data.turns, imu_data.yaw);
+        my_printf(&huart2,"偏航角速度: %.2f °/s (原始 %.2f)\r\n", heading_data.yaw_rate, imu_data.gz);
+        my_printf(&huart2,"陀螺仪零偏: %.3f °/s, 偏航角漂移率: %.3f °/s (%s)\r\n",
+                  heading_data.gyro_bias, heading_data.drift_rate, heading_data.bias_valid ? "已估计" : "未估计，停车后自动估计");
+        my_printf(&huart2,"静止: %s, 累计静止 %.1f s\r\n", heading_data.still ? "是" : "否", heading_data.still_time_ms * 0.001f);
+        my_printf(&huart2,"静止期间拒绝漂移: %.2f°, 运动期间扣除漂移: %.2f°\r\n",
+                  heading_data.drift_rejected, heading_data.drift_corrected);
+        my_printf(&huart2,"--- 角速度融合 (交叉频率 %.2f Hz) ---\r\n", yaw_fusion.crossover_hz);
+        my_printf(&huart2,"融合: %.3f rad/s, 陀螺仪: %.3f rad/s, 编码器: %.3f rad/s\r\n",
+                  yaw_fusion.yaw_rate, yaw_fusion.omega_gyro, yaw_fusion.omega_enc);
+        my_printf(&huart2,"融合航向: %.2f°\r\n", yaw_fusion.heading);
+        my_printf(&huart2,"打滑: %s, 次数 %lu, 累计 %.1f s\r\n", yaw_fusion.slip ? "是(只用陀螺仪)" : "否",
+                  (unsigned long)yaw_fusion.slip_count, yaw_fusion.slip_time_ms * 0.001f);
+        return;
+    }
+
+    if (param_count == 1 && strcmp(params[0], "zero") == 0) {
+        Heading_Zero(&heading_data);
+        Fusion_ZeroHeading(&yaw_fusion);
+        my_printf(&huart2,"航向已置零\r\n");
+        return;
+    }
+
+    if (param_count == 2 && strcmp(params[0], "fc") == 0) {
+        Fusion_SetCrossover(&yaw_fusion, atof(params[1]));
+        my_printf(&huart2,"角速度融合交叉频率: %.2f Hz\r\n", yaw_fusion.crossover_hz);
+        return;
+    }
+
+    my_printf(&huart2,"错误：格式: heading [zero|fc <hz>]\r\n");
+}
+
+// 打印IMU配置档一行
+static void print_imu_config(const char* label, const IMU_Config_t* cfg) {
+    my_printf(&huart2,"%s: 速率 %.1f Hz, 带宽 %u Hz, 内容 0x%03X, %s\r\n", label,
+              IMU_RateCodeToHz(cfg->rate), IMU_BandwidthCodeToHz(cfg->bandwidth),
+              cfg->content, cfg->axis6 == ALGRITHM6 ? "6轴" : "9轴");
+}
+
+// 打印配置应用结果
+static void print_imu_config_result(uint8_t result) {
+    if (result & IMU_CFG_F_ERROR) {
+        my_printf(&huart2,"配置应用失败 (回读或校验不一致)\r\n");
+    } else if (result == 0) {
+        my_printf(&huart2,"模块配置与目标一致，未写入\r\n");
+    } else {
+        my_printf(&huart2,"已写入:%s%s%s%s 并保存\r\n",
+                  (result & IMU_CFG_F_RATE) ? " 速率" : "",
+                  (result & IMU_CFG_F_BANDWIDTH) ? " 带宽" : "",
+                  (result & IMU_CFG_F_CONTENT) ? " 内容" : "",
+                  (result & IMU_CFG_F_AXIS6) ? " 算法" : "");
+    }
+}
+
+// IMU配置档命令 - imu config [apply|rate <hz>|bw <hz>|axis <6|9>]
+static void handle_IMU_CONFIG_command(char** params, int param_count) {
+    IMU_Config_t cur;
+    int value, code;
+
+    if (!IMU_IsInitialized()) {
+        my_printf(&huart2,"IMU未初始化\r\n");
+        return;
+    }
+
+    if (param_count == 0) {
+        my_printf(&huart2,"=== IMU配置档 ===\r\n");
+        print_imu_config("目标", &imu_config);
+        if (IMU_ReadConfig(&cur)) {
+            print_imu_config("模块", &cur);
+        } else {
+            my_printf(&huart2,"模块配置回读失败\r\n");
+        }
+        my_printf(&huart2,"启动/上次应用结果: ");
+        print_imu_config_result(imu_config_result);
+        return;
+    }
+
+    // 写入配置逐个寄存器HAL_Delay等待，期间控制环不更新
+    if (enable) {
+        my_printf(&huart2,"错误：电机运行中，请先使用'stop'停止电机\r\n");
+        return;
+    }
+
+    if (param_count == 1 && strcmp(params[0], "apply") == 0) {
+        imu_config_result = IMU_ApplyConfig(&imu_config);
+        print_imu_config_result(imu_config_result);
+        return;
+    }
+
+    if (param_count == 2) {
+        value = atoi(params[1]);
+        if (strcmp(params[0], "rate") == 0) {
+            for (code = RRATE_02HZ; code <= RRATE_200HZ; code++) {
+                if (fabsf(IMU_RateCodeToHz(code) - (float)value) < 0.5f) break;
+            }
+            if (code > RRATE_200HZ || value <= 0) {
+                my_printf(&huart2,"错误：速率可选 1 2 5 10 20 50 100 200 Hz\r\n");
+                return;
+            }
+            imu_config.rate = code;
+        } else if (strcmp(params[0], "bw") == 0) {
+            for (code = BANDWIDTH_256HZ; code <= BANDWIDTH_5HZ; code++) {
+                if (IMU_BandwidthCodeToHz(code) == value) break;
+            }
+            if (code > BANDWIDTH_5HZ) {
+                my_printf(&huart2,"错误：带宽可选 256 184 94 44 21 10 5 Hz\r\n");
+                return;
+            }
+            imu_config.bandwidth = code;
+        } else if (strcmp(params[0], "axis") == 0 && (value == 6 || value == 9)) {
+            imu_config.axis6 = (value == 6) ? ALGRITHM6 : ALGRITHM9;
+        } else {
+            my_printf(&huart2,"错误：格式: imu config [apply|rate <hz>|bw <hz>|axis <6|9>]\r\n");
+            return;
+        }
+        imu_config_result = IMU_ApplyConfig(&imu_config);
+        print_imu_config("目标", &imu_config);
+        print_imu_config_result(imu_config_result);
+        return;
+    }
+
+    my_printf(&huart2,"错误：格式: imu config [apply|rate <hz>|bw <hz>|axis <6|9>]\r\n");
+}
+
+// IMU链路命令处理函数 - 支持imu [reset|config]格式
+void handle_IMU_command_with_params(char** params, int param_count) {
+    const IMU_Stream_Stats_t* st = IMU_Stream_GetStats();
+
+    if (param_count >= 1 && strcmp(params[0], "config") == 0) {
+        handle_IMU_CONFIG_command(params + 1, param_count - 1);
+        return;
+    }
+
+    if (param_count == 0) {
+        my_printf(&huart2,"=== IMU链路 ===\r\n");
+#if IMU_TRANSPORT == IMU_TRANSPORT_UART
+        my_printf(&huart2,"传输方式: USART1串口流 %d bps, DMA缓冲 %d 字节 (%s)\r\n",
+                  IMU_UART_BAUD, IMU_STREAM_BUF_SIZE, st->running ? "接收中" : "未启动");
+#else
+        my_printf(&huart2,"传输方式: I2C2轮询 (IMU_TRANSPORT改为IMU_TRANSPORT_UART启用串口流)\r\n");
+#endif
+        my_printf(&huart2,"样本序号: %lu, 最近样本 %lu ms, 通信错误 %d\r\n",
+                  (unsigned long)imu_data.sample_seq, (unsigned long)imu_data.sample_time, imu_data.comm_error_count);
+        if (st->running) {
+            my_printf(&huart2,"接收字节: %lu, 有效帧: %lu, 距最近一帧 %lu ms\r\n",
+                      (unsigned long)st->bytes, (unsigned long)st->frames,
+                      (unsigned long)(HAL_GetTick() - st->last_frame_tick));
+            my_printf(&huart2,"校验错误: %lu, 重同步丢弃字节: %lu, 串口溢出: %lu\r\n",
+                      (unsigned long)st->checksum_errors, (unsigned long)st->skipped_bytes, (unsigned long)st->overruns);
+            my_printf(&huart2,"最大积压: %u / %d 字节\r\n", st->max_backlog, IMU_STREAM_BUF_SIZE);
+        }
+        return;
+    }
+
+    if (param_count == 1 && strcmp(params[0], "reset") == 0) {
+        IMU_Stream_ResetStats();
+        IMU_ClearError();
+        my_printf(&huart2,"IMU链路统计已清除\r\n");
+        return;
+    }
+
+    my_printf(&huart2,"错误：格式: imu [reset|config]\r\n");
+}
+
+// 曲率自适应速度规划命令处理函数 - 支持planner [on|off|<a_lat> <v_max>]格式
+void handle_PLANNER_command_with_params(char** params, int param_count) {
+    if (param_count == 0) {
+        my_printf(&huart2,"=== 曲率自适应速度规划 ===\r\n");
+        my_printf(&huart2,"状态: %s\r\n", speed_planner.enabled ? "已使能" : "未使能(使用basic_speed)");
+        my_printf(&huart2,"横向加速度限制: %.2f m/s², 速度范围: %.2f~%.2f m/s\r\n",
+                  speed_planner.a_lat, speed_planner.v_min, speed_planner.v_max);
+        my_printf(&huart2,"实测角速度: %.2f rad/s\r\n", speed_planner.yaw_rate);
+        my_printf(&huart2,"曲率: 车体 %.2f, 偏差 %.2f, 增长率 %.2f, 规划 %.2f (1/m)\r\n",
+                  speed_planner.kappa_body, speed_planner.kappa_line, speed_planner.kappa_rate, speed_planner.kappa);
+        my_printf(&huart2,"速度目标: %.3f m/s\r\n", speed_planner.v_target);
+        return;
+    }
+
+    if (param_count == 1) {
+        if (strcmp(params[0], "on") == 0 || strcmp(params[0], "off") == 0) {
+            uint8_t on = (strcmp(params[0], "on") == 0);
+            Planner_Enable(&speed_planner, on);
+            my_printf(&huart2,"曲率自适应速度规划已%s\r\n", on ? "使能" : "禁用，恢复使用basic_speed");
+            return;
+        }
+    }
+
+    if (param_count == 2) {
+        float a_lat = atof(params[0]);
+        float v_max = atof(params[1]);
+
+        // 参数范围验证
+        if (a_lat <= 0.0f || a_lat > 20.0f || v_max <= speed_planner.v_min || v_max > BODY_WHEEL_SPEED_MAX) {
+            my_printf(&huart2,"错误：横向加速度范围 (0, 20] m/s²，直道速度范围 (%.2f, %.1f] m/s\r\n",
+                      speed_planner.v_min, BODY_WHEEL_SPEED_MAX);
+            return;
+        }
+
+        Planner_SetLimits(&speed_planner, a_lat, v_max);
+        my_printf(&huart2,"速度规划限制已更新: %.2f m/s², 直道 %.2f m/s\r\n", a_lat, v_max);
+        my_printf(&huart2,"直道速度对应最小转弯半径: %.2f m\r\n", v_max * v_max / a_lat);
+        return;
+    }
+
+    my_printf(&huart2,"错误：格式: planner [on|off] 或 planner <a_lat> <v_max>\r\n");
+}
+
+// 赛道学习命令处理函数 - 支持track [learn|stop|run|dump|save|load]格式
+void handle_TRACK_command_with_params(char** params, int param_count) {
+    if (param_count == 0) {
+        my_printf(&huart2,"=== 赛道学习 ===\r\n");
+        my_printf(&huart2,"模式: %s\r\n", Track_GetModeName(track_map.mode));
+        if (track_map.mode == TRACK_LEARNING) {
+            my_printf(&huart2,"已学习里程: %.2f m\r\n", track_map.position);
+            return;
+        }
+        if (track_map.map.bin_count < 2) {
+            my_printf(&huart2,"无有效地图，将小车置于起跑线路口后使用 track learn + start 学习首圈\r\n");
+            return;
+        }
+        my_printf(&huart2,"圈长: %.2f m (%u格)\r\n", track_map.map.bin_count * TRACK_BIN_M, track_map.map.bin_count);
+        my_printf(&huart2,"当前位置: %.2f m, 速度目标: %.3f m/s\r\n", track_map.position, Track_GetSpeed(&track_map));
+        my_printf(&huart2,"圈数: %lu, 上圈用时: %lu ms\r\n", track_map.lap_count, track_map.last_lap_ms);
+        my_printf(&huart2,"事件定位: %lu次, 最近校正 %.3f m\r\n", track_map.loc_count, track_map.last_correction);
+        return;
+    }
+
+    if (param_count == 1) {
+        if (strcmp(params[0], "learn") == 0) {
+            Track_StartLearning(&track_map);
+            my_printf(&huart2,"开始学习首圈，再次进入起跑线路口时自动闭环(或track stop手动闭环)\r\n");
+            return;
+        }
+        if (strcmp(params[0], "stop") == 0) {
+            if (track_map.mode == TRACK_LEARNING) {
+                if (Track_FinishLearning(&track_map)) {
+                    Track_Stop(&track_map);
+                    my_printf(&huart2,"学习完成: 圈长 %.2f m\r\n", track_map.map.bin_count * TRACK_BIN_M);
+                } else {
+                    my_printf(&huart2,"学习作废: 里程过短\r\n");
+                }
+                return;
+            }
+            Track_Stop(&track_map);
+            my_printf(&huart2,"已停止地图跟随\r\n");
+            return;
+        }
+        if (strcmp(params[0], "run") == 0) {
+            if (Track_StartRunning(&track_map)) {
+                Track_ComputeSpeedProfile(&track_map); // 使用当前planner/profile限制
+                my_printf(&huart2,"从起跑线开始按地图跟随\r\n");
+            } else {
+                my_printf(&huart2,"错误：无有效地图\r\n");
+            }
+            return;
+        }
+        if (strcmp(params[0], "dump") == 0) {
+            if (enable) {
+                my_printf(&huart2,"错误：请先stop停止电机\r\n");
+                return;
+            }
+            my_printf(&huart2,"bin,dist_m,kappa,flags,v\r\n");
+            for (uint16_t i = 0; i < track_map.map.bin_count; i++) {
+                my_printf(&huart2,"%u,%.2f,%.3f,0x%02X,%.3f\r\n", i, i * TRACK_BIN_M,
+                          track_map.map.bins[i].kappa / TRACK_KAPPA_SCALE,
+                          track_map.map.bins[i].flags, track_map.speed[i]);
+            }
+            return;
+        }
+        if (strcmp(params[0], "save") == 0) {
+            if (enable) {
+                my_printf(&huart2,"错误：擦写Flash期间CPU停顿，请先stop停止电机\r\n");
+                return;
+            }
+            my_printf(&huart2,"%s\r\n", Track_Save(&track_map) ? "地图已保存到Flash" : "保存失败(无有效地图或Flash错误)");
+            return;
+        }
+        if (strcmp(params[0], "load") == 0) {
+            my_printf(&huart2,"%s\r\n", Track_Load(&track_map) ? "已从Flash加载地图" : "Flash中无有效地图");
+            return;
+        }
+    }
+
+    my_printf(&huart2,"错误：格式: track [learn|stop|run|dump|save|load]\r\n");
+}
+
+// Gary灰度标定命令处理函数 - 支持gary cal [start|stop|white|black|save]格式
+void handle_GARY_CAL_command_with_params(char** params, int param_count) {
+    if (param_count == 1) {
+        if (strcmp(params[0], "start") == 0) {
+            Gary_CalibrationStart();
+            my_printf(&huart2,"扫描标定开始：请让所有传感器在黑线和白色区域间来回扫过\r\n");
+            my_printf(&huart2,"完成后输入 gary cal stop\r\n");
+            return;
+        }
+
+        if (strcmp(params[0], "save") == 0) {
+            // Flash擦写期间CPU停顿，控制环无法更新
+            if (enable) {
+                my_printf(&huart2,"错误：电机运行中，请先使用'stop'停止电机\r\n");
+                return;
+            }
+            my_printf(&huart2,"标定数据保存%s\r\n", Gary_SaveCalibration() ? "成功" : "失败");
+            return;
+        }
+
+        if (strcmp(params[0], "stop") == 0) {
+            if (!Gary_IsCalibrating()) {
+                my_printf(&huart2,"错误：未在扫描标定，请先输入 gary cal start\r\n");
+                return;
+            }
+            uint8_t valid = Gary_CalibrationStop();
+            if (valid == 0) {
+                my_printf(&huart2,"扫描标定失败：未检测到足够的黑白差，标定未更新\r\n");
+                return;
+            }
+            my_printf(&huart2,"扫描标定完成：%u/8个通道有效\r\n", valid);
+            if (enable) {
+                my_printf(&huart2,"电机运行中，未保存到Flash，停止后输入 gary cal save\r\n");
+            } else {
+                my_printf(&huart2,"标定数据保存%s\r\n", Gary_SaveCalibration() ? "成功" : "失败");
+            }
+        } else if (!Gary_IsDataReady()) {
+            my_printf(&huart2,"Gary数据未就绪，无法标定\r\n");
+            return;
+        } else if (strcmp(params[0], "white") == 0) {
+            Gary_CalibrateWhite();
+            my_printf(&huart2,"白场标定完成 (请确认传感器全部位于白色区域)\r\n");
+        } else if (strcmp(params[0], "black") == 0) {
+            Gary_CalibrateBlack();
+            my_printf(&huart2,"黑场标定完成 (请确认传感器全部位于黑线上)\r\n");
+        } else {
+            my_printf(&huart2,"错误：无效标定参数 '%s'\r\n", params[0]);
+            my_printf(&huart2,"支持的参数: start, stop, white, black, save\r\n");
+            return;
+        }
+    }
+
+    // 显示当前标定数据
+    const Gary_Calibration_t *cal = Gary_GetCalibration();
+    my_printf(&huart2,"=== Gary灰度标定 ===\r\n");
+    my_printf(&huart2,"白场: ");
+    for (uint8_t i = 0; i < 8; i++) {
+        my_printf(&huart2,"%3u ", cal->white[i]);
+    }
+    my_printf(&huart2,"\r\n黑场: ");
+    for (uint8_t i = 0; i < 8; i++) {
+        my_printf(&huart2,"%3u ", cal->black[i]);
+    }
+    my_printf(&huart2,"\r\n");
+    if (Gary_IsCalibrating()) {
+        my_printf(&huart2,"扫描标定进行中...\r\n");
+    }
+    if (param_count == 0) {
+        my_printf(&huart2,"使用格式: gary cal start/stop (扫描标定并保存)\r\n");
+        my_printf(&huart2,"          gary cal white/black (以当前值标定)，gary cal save (保存)\r\n");
+    }
+}
+
+// 电机输出整形命令处理函数 - 支持motor [characterize|curve|shape on|off|deadband <l> <r>|reset]格式
+void handle_MOTOR_command_with_params(char** params, int param_count) {
+    if (param_count == 0) {
+        const char *names[MOTOR_SHAPE_MOTOR_NUM] = {"左轮", "右轮"};
+        my_printf(&huart2,"=== 电机输出整形 ===\r\n");
+        my_printf(&huart2,"整形: %s, 特性标定: %s\r\n", motor_shape.enabled ? "开" : "关",
+                  Shape_GetCharStateName(motor_shape.char_state));
+        if (motor_shape.full_speed > 0.0f) {
+            my_printf(&huart2,"效果值%d对应轮速: %.2f m/s\r\n", MOTOR_SHAPE_PWM_MAX, motor_shape.full_speed);
+        }
+        for (uint8_t m = 0; m < MOTOR_SHAPE_MOTOR_NUM; m++) {
+            my_printf(&huart2,"%s 死区: %d, 查找表:", names[m], motor_shape.table[m].deadband);
+            for (uint8_t i = 0; i < MOTOR_SHAPE_POINTS; i++) {
+                my_printf(&huart2," %d", motor_shape.table[m].pwm[i]);
+            }
+            my_printf(&huart2,"\r\n");
+        }
+        return;
+    }
+
+    if (param_count == 1 && strcmp(params[0], "characterize") == 0) {
+        if (enable) {
+            my_printf(&huart2,"错误：电机运行中，请先stop\r\n");
+            return;
+        }
+        uint32_t total_ms = MOTOR_CHAR_SPINUP_MS + MOTOR_CHAR_MEASURE_MS
+                          + (MOTOR_CHAR_STEPS - 1) * (MOTOR_CHAR_SETTLE_MS + MOTOR_CHAR_MEASURE_MS);
+        Shape_StartCharacterize(&motor_shape, HAL_GetTick());
+        enable = 1;  // 由pid_task接管电机输出，stop中止
+        my_printf(&huart2,"开始电机特性标定 (车轮需架空)，PWM %d→0 步长%d，约%lus，stop中止\r\n",
+                  MOTOR_SHAPE_PWM_MAX, MOTOR_CHAR_PWM_STEP, (total_ms + 999) / 1000);
+        return;
+    }
+
+    if (param_count == 1 && strcmp(params[0], "curve") == 0) {
+        if (Shape_IsCharacterizing(&motor_shape)) {
+            my_printf(&huart2,"错误：标定进行中\r\n");
+            return;
+        }
+        my_printf(&huart2,"pwm,left_m_s,right_m_s\r\n");
+        for (uint16_t j = 0; j < MOTOR_CHAR_STEPS; j++) {
+            my_printf(&huart2,"%d,%.3f,%.3f\r\n", j * MOTOR_CHAR_PWM_STEP,
+                      motor_shape.char_speed[MOTOR_ID_LEFT][j], motor_shape.char_speed[MOTOR_ID_RIGHT][j]);
+        }
+        return;
+    }
+
+    if (param_count == 1 && strcmp(params[0], "reset") == 0) {
+        Shape_ResetTables(&motor_shape);
+        my_printf(&huart2,"输出整形已恢复恒等映射 (死区0)\r\n");
+        return;
+    }
+
+    if (param_count == 2 && strcmp(params[0], "shape") == 0) {
+        if (strcmp(params[1], "on") == 0 || strcmp(params[1], "off") == 0) {
+            motor_shape.enabled = (strcmp(params[1], "on") == 0);
+            my_printf(&huart2,"输出整形已%s\r\n", motor_shape.enabled ? "开启" : "关闭 (速度环输出直接作为PWM)");
+            return;
+        }
+    }
 
+    if (param_count == 3 && strcmp(params[0], "deadband") == 0) {
+        int left = atoi(params[1]);
+        int right = atoi(params[2]);
+
+        // 参数范围验证
+        if (left < 0 || left > MOTOR_SHAPE_PWM_MAX / 2 || right < 0 || right > MOTOR_SHAPE_PWM_MAX / 2) {
+            my_printf(&huart2,"错误：死区范围为 0 到 %d\r\n", MOTOR_SHAPE_PWM_MAX / 2);
+            return;
+        }
+        Shape_SetDeadband(&motor_shape, MOTOR_ID_LEFT, (int16_t)left);
+        Shape_SetDeadband(&motor_shape, MOTOR_ID_RIGHT, (int16_t)right);
+        my_printf(&huart2,"死区补偿已设置: 左 %d, 右 %d\r\n", left, right);
+        return;
+    }
+
+    my_printf(&huart2,"错误：格式: motor [characterize|curve|reset|shape on|off|deadband <l> <r>]\r\n");
+}
+
+// 电池电压补偿命令处理函数 - 支持battery [on|off|cal <V>]格式
+void handle_BATTERY_command_with_params(char** params, int param_count) {
+    if (param_count == 0) {
+        my_printf(&huart2,"=== 电池电压补偿 ===\r\n");
+        my_printf(&huart2,"电压补偿: %s, 标称电压: %.2fV, 分压比: %.2f\r\n",
+                  battery.enabled ? "开" : "关", VBAT_NOMINAL, battery.divider_ratio);
+        if (!battery.valid) {
+            my_printf(&huart2,"电池电压: %.2fV (低于%.1fV，视为未接电池，不补偿)\r\n", battery.vbat, VBAT_VALID_MIN);
+            return;
+        }
+        my_printf(&huart2,"电池电压: %.2fV, 滤波: %.2fV\r\n", battery.vbat, battery.vbat_filtered);
+        my_printf(&huart2,"补偿系数: %.3f, 降额系数: %.3f, 总系数: %.3f\r\n",
+                  battery.comp, battery.derate, battery.factor);
+        return;
+    }
+
+    if (param_count == 1 && (strcmp(params[0], "on") == 0 || strcmp(params[0], "off") == 0)) {
+        battery.enabled = (strcmp(params[0], "on") == 0);
+        my_printf(&huart2,"电池电压补偿与低压降额已%s\r\n", battery.enabled ? "开启" : "关闭");
+        return;
+    }
+
+    if (param_count == 2 && strcmp(params[0], "cal") == 0) {
+        // 电机运行时电池带载压降，标定需在停止时进行
+        if (enable) {
+            my_printf(&huart2,"错误：电机运行中，请先使用'stop'停止电机\r\n");
+            return;
+        }
+        if (!Battery_Calibrate(&battery, atof(params[1]))) {
+            my_printf(&huart2,"错误：电压需不低于%.1fV，且ADC引脚电压需高于%.1fV (当前%.3fV)\r\n",
+                      VBAT_VALID_MIN, VBAT_CAL_PIN_MIN, voltage);
+            return;
+        }
+        my_printf(&huart2,"分压比已标定: %.3f (不保存，重启后恢复%.2f)\r\n", battery.divider_ratio, VBAT_DIVIDER_RATIO);
+        return;
+    }
+
+    my_printf(&huart2,"错误：格式: battery [on|off|cal <V>]\r\n");
+}
+
+// 减速制动命令处理函数 - 支持brake [on|off]格式
+void handle_BRAKE_command_with_params(char** params, int param_count) {
+    if (param_count == 0) {
+        const char *names[PID_SPEED_NUM] = {"左轮", "右轮"};
+        my_printf(&huart2,"=== 减速短路制动 ===\r\n");
+        my_printf(&huart2,"状态: %s, 进入/退出超速量: %.2f/%.2f m/s, 满制动超速量: %.2f m/s\r\n",
+                  decel_control.enabled ? "已使能" : "未使能", DECEL_BRAKE_ENTER, DECEL_BRAKE_EXIT, DECEL_BRAKE_FULL_ERR);
+        for (uint8_t c = 0; c < PID_SPEED_NUM; c++) {
+            my_printf(&huart2,"%s: %s 强度%u, 制动次数 %lu, 累计 %lu ms\r\n", names[c],
+                      decel_control.braking[c] ? "制动中" : "驱动", decel_control.strength[c],
+                      decel_control.brake_count[c], decel_control.brake_ms[c]);
+        }
+        return;
+    }
+
+    if (param_count == 1 && (strcmp(params[0], "on") == 0 || strcmp(params[0], "off") == 0)) {
+        decel_control.enabled = (strcmp(params[0], "on") == 0);
+        my_printf(&huart2,"减速短路制动已%s\r\n", decel_control.enabled ? "使能" : "禁用");
+        return;
+    }
+
+    my_printf(&huart2,"错误：格式: brake [on|off]\r\n");
+}
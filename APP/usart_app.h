@@ -39,7 +39,7 @@ int parse_command_params(char *input, char **cmd, char **params, int max_params)
 void handle_SENSOR_command(void);
 
 /**
- * @brief PWM参数化指令处理函数 - 支持pwm [left|right] [value]格式
+ * @brief PWM参数化指令处理函数 - 支持pwm [left|right] [value] / pwm bench [n]格式
  */
 void handle_PWM_command_with_params(char** params, int param_count);
 
@@ -100,6 +100,11 @@ void handle_GARY_STATE_command(void);
  */
 void handle_GARY_REINIT_command(void);
 
+/**
+ * @brief Gary灰度标定命令处理函数 - 支持gary cal [start|stop|white|black|save]格式
+ */
+void handle_GARY_CAL_command_with_params(char** params, int param_count);
+
 /**
  * @brief Gary传感器调试命令
  */
@@ -115,4 +120,64 @@ void handle_SPEED_command_with_params(char** params, int param_count);
  */
 void handle_PID_command_with_params(char** params, int param_count);
 
+/**
+ * @brief 速度规划参数命令处理函数 - 支持profile [accel] [jerk] [decel]格式
+ */
+void handle_PROFILE_command_with_params(char** params, int param_count);
+
+/**
+ * @brief 闭环基准测试命令处理函数 - 支持bench [step|ramp|disturb|line]格式
+ */
+void handle_BENCH_command_with_params(char** params, int param_count);
+
+/**
+ * @brief 丢线恢复命令处理函数 - 支持recover [reset]格式
+ */
+void handle_RECOVER_command_with_params(char** params, int param_count);
+
+/**
+ * @brief 曲率自适应速度规划命令处理函数 - 支持planner [on|off|<a_lat> <v_max>]格式
+ */
+void handle_PLANNER_command_with_params(char** params, int param_count);
+
+/**
+ * @brief 航向命令处理函数 - 支持heading [zero|fc <hz>]格式
+ */
+void handle_HEADING_command_with_params(char** params, int param_count);
+
+/**
+ * @brief IMU链路命令处理函数 - 支持imu [reset|config]格式
+ */
+void handle_IMU_command_with_params(char** params, int param_count);
+
+/**
+ * @brief Gary自适应阈值命令处理函数 - 支持gary stats [on|off|reset]格式
+ */
+void handle_GARY_STATS_command_with_params(char** params, int param_count);
+
+/**
+ * @brief Gary自适应采集命令处理函数 - 支持gary acq [on|off|reset]格式
+ */
+void handle_GARY_ACQ_command_with_params(char** params, int param_count);
+
+/**
+ * @brief 减速制动命令处理函数 - 支持brake [on|off]格式
+ */
+void handle_BRAKE_command_with_params(char** params, int param_count);
+
+/**
+ * @brief 电池电压补偿命令处理函数 - 支持battery [on|off]格式
+ */
+void handle_BATTERY_command_with_params(char** params, int param_count);
+
+/**
+ * @brief 电机输出整形命令处理函数 - 支持motor [characterize|curve|reset|shape on|off|deadband <l> <r>]格式
+ */
+void handle_MOTOR_command_with_params(char** params, int param_count);
+
+/**
+ * @brief 赛道学习命令处理函数 - 支持track [learn|stop|run|dump|save|load]格式
+ */
+void handle_TRACK_command_with_params(char** params, int param_count);
+
 #endif
\ No newline at end of file
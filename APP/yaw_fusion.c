@@ -0,0 +1,132 @@
+/**
+ * @file yaw_fusion.c
+ * @brief 角速度融合模块实现 - 互补滤波与打滑检测
+ * @note 1. 陀螺仪无量化、无滞后但有零偏漂移；编码器轮速差无漂移但有滑动平均滞后和打滑误差。
+ *          y = α(y + Δω_gyro) + (1-α)ω_enc，等效于陀螺仪一阶高通 + 编码器一阶低通，
+ *          α = τ/(τ+dt)，τ = 1/(2π·fc)
+ *       2. 打滑门限：|ω_enc - ω_gyro| > FUSION_SLIP_RATE 时认为车轮打滑或离地，
+ *          此后FUSION_SLIP_HOLD_MS内只用陀螺仪
+ *       3. 陀螺仪不可用(IMU未就绪)时只用编码器
+ *       编码器速度为幅值，原地反向转动时ω_enc符号不可靠，此时会触发打滑门限转为只用陀螺仪。
+ */
+#include "yaw_fusion.h"
+
+#define FUSION_RAD_TO_DEG     (180.0f / 3.14159265f)
+
+Yaw_Fusion_t yaw_fusion;
+
+/**
+ * @brief 按交叉频率和周期计算互补滤波系数
+ */
+static void Fusion_UpdateAlpha(Yaw_Fusion_t* yf, float dt) {
+    float tau = 1.0f / (2.0f * 3.14159265f * yf->crossover_hz);
+
+    yf->alpha = tau / (tau + dt);
+    yf->alpha_dt = dt;
+}
+
+/**
+ * @brief 角速度融合初始化函数
+ * @param yf 融合数据指针
+ * @param crossover_hz 交叉频率(Hz)
+ */
+void Fusion_Init(Yaw_Fusion_t* yf, float crossover_hz) {
+    if (yf == NULL) return;
+
+    memset(yf, 0, sizeof(Yaw_Fusion_t));
+    Fusion_SetCrossover(yf, crossover_hz);
+}
+
+/**
+ * @brief 设置交叉频率
+ * @param yf 融合数据指针
+ * @param crossover_hz 交叉频率(Hz)，限制在FUSION_CROSSOVER_MIN_HZ~FUSION_CROSSOVER_MAX_HZ
+ */
+void Fusion_SetCrossover(Yaw_Fusion_t* yf, float crossover_hz) {
+    if (yf == NULL) return;
+
+    if (crossover_hz < FUSION_CROSSOVER_MIN_HZ) crossover_hz = FUSION_CROSSOVER_MIN_HZ;
+    if (crossover_hz > FUSION_CROSSOVER_MAX_HZ) crossover_hz = FUSION_CROSSOVER_MAX_HZ;
+    yf->crossover_hz = crossover_hz;
+    yf->alpha_dt = 0.0f;    // 下次更新时按实际周期重新计算
+}
+
+/**
+ * @brief 角速度融合周期更新函数
+ * @param yf 融合数据指针
+ * @param omega_gyro 陀螺仪角速度(rad/s，已去零偏)
+ * @param gyro_valid 陀螺仪数据可用
+ * @param omega_enc 编码器轮速差角速度(rad/s)
+ * @param dt 更新周期(s)
+ * @param now_ms 当前时间(ms)
+ * @return 融合角速度(rad/s)
+ */
+float Fusion_Update(Yaw_Fusion_t* yf, float omega_gyro, uint8_t gyro_valid, float omega_enc, float dt, uint32_t now_ms) {
+    if (yf == NULL) return omega_enc;
+
+    if (dt != yf->alpha_dt) {
+        Fusion_UpdateAlpha(yf, dt);
+    }
+    yf->omega_gyro = omega_gyro;
+    yf->omega_enc = omega_enc;
+
+    if (!gyro_valid) {
+        // IMU未就绪：只用编码器
+        yf->yaw_rate = omega_enc;
+        yf->slip = 0;
+    } else {
+        // 1. 打滑门限：编码器与陀螺仪不一致时暂停使用编码器
+        if (fabsf(omega_enc - omega_gyro) > FUSION_SLIP_RATE) {
+            if (!yf->slip) {
+                yf->slip_count++;
+            }
+            yf->slip = 1;
+            yf->slip_until = now_ms + FUSION_SLIP_HOLD_MS;
+        } else if (yf->slip && (int32_t)(now_ms - yf->slip_until) >= 0) {
+            yf->slip = 0;
+        }
+
+        // 2. 互补滤波 (陀螺仪刚恢复时从陀螺仪开始，避免差分跳变)
+        if (yf->slip || !yf->gyro_valid) {
+            yf->yaw_rate = omega_gyro;
+        } else {
+            yf->yaw_rate = yf->alpha * (yf->yaw_rate + omega_gyro - yf->prev_gyro)
+                         + (1.0f - yf->alpha) * omega_enc;
+        }
+        yf->prev_gyro = omega_gyro;
+        if (yf->slip) {
+            yf->slip_time_ms += (uint32_t)(dt * 1000.0f);
+        }
+    }
+    yf->gyro_valid = gyro_valid;
+
+    // 3. 航向积分
+    yf->heading += yf->yaw_rate * dt * FUSION_RAD_TO_DEG;
+    yf->update_count++;
+
+    return yf->yaw_rate;
+}
+
+/**
+ * @brief 获取融合角速度
+ * @return 角速度(rad/s，逆时针为正)
+ */
+float Fusion_GetYawRate(const Yaw_Fusion_t* yf) {
+    return (yf != NULL) ? yf->yaw_rate : 0.0f;
+}
+
+/**
+ * @brief 获取融合航向
+ * @return 连续航向(度)
+ */
+float Fusion_GetHeading(const Yaw_Fusion_t* yf) {
+    return (yf != NULL) ? yf->heading : 0.0f;
+}
+
+/**
+ * @brief 融合航向置零 (保留角速度状态和打滑统计)
+ */
+void Fusion_ZeroHeading(Yaw_Fusion_t* yf) {
+    if (yf == NULL) return;
+    yf->heading = 0.0f;
+}
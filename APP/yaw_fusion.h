@@ -0,0 +1,60 @@
+/**
+ * @file yaw_fusion.h
+ * @brief 角速度融合模块头文件 - 陀螺仪高通 + 编码器轮速差低通的互补滤波，带打滑门限
+ */
+#ifndef YAW_FUSION_H
+#define YAW_FUSION_H
+
+#include "mydefine.h"
+
+// 角速度融合配置参数已迁移到mydefine.h统一管理
+
+// 角速度融合数据结构
+typedef struct {
+    float yaw_rate;                // 融合角速度(rad/s，逆时针为正)，控制环与里程唯一角速度来源
+    float heading;                 // 融合角速度积分的连续航向(度)
+    float omega_gyro;              // 陀螺仪角速度(rad/s，已去零偏)
+    float omega_enc;               // 编码器轮速差角速度(rad/s)
+
+    float crossover_hz;            // 交叉频率(Hz)：低于此频率信编码器，高于此频率信陀螺仪
+    float alpha;                   // 互补滤波系数 τ/(τ+dt)
+    float alpha_dt;                // alpha对应的更新周期(s)
+    float prev_gyro;               // 上次陀螺仪角速度(rad/s)
+    uint8_t gyro_valid;            // 上次更新时陀螺仪可用
+
+    uint8_t slip;                  // 打滑标志 (编码器与陀螺仪不一致，暂不使用编码器)
+    uint32_t slip_until;           // 打滑保持截止时间(ms)
+    uint32_t slip_count;           // 打滑事件次数
+    uint32_t slip_time_ms;         // 累计打滑时间(ms)
+    uint32_t update_count;         // 更新次数
+} Yaw_Fusion_t;
+
+extern Yaw_Fusion_t yaw_fusion; // 全局角速度融合
+
+/**
+ * @brief 角速度融合初始化函数
+ */
+void Fusion_Init(Yaw_Fusion_t* yf, float crossover_hz);
+
+/**
+ * @brief 设置交叉频率(Hz)
+ */
+void Fusion_SetCrossover(Yaw_Fusion_t* yf, float crossover_hz);
+
+/**
+ * @brief 角速度融合周期更新函数
+ */
+float Fusion_Update(Yaw_Fusion_t* yf, float omega_gyro, uint8_t gyro_valid, float omega_enc, float dt, uint32_t now_ms);
+
+/**
+ * @brief 获取融合角速度(rad/s)/融合航向(度)
+ */
+float Fusion_GetYawRate(const Yaw_Fusion_t* yf);
+float Fusion_GetHeading(const Yaw_Fusion_t* yf);
+
+/**
+ * @brief 融合航向置零
+ */
+void Fusion_ZeroHeading(Yaw_Fusion_t* yf);
+
+#endif
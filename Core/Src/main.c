@@ -100,7 +100,9 @@ int main(void)
   MX_TIM4_Init();
   MX_I2C3_Init();
   MX_USART2_UART_Init();
+  MX_USART1_UART_Init();
   /* USER CODE BEGIN 2 */
+  Perf_Init();
   IMU_Init();
   Encoder_Init();
   OLED_Init();
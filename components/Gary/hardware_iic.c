@@ -39,6 +39,16 @@ unsigned char IIC_Get_Anolog(unsigned char * Result,unsigned char len)
 	if(IIC_ReadBytes(GW_GRAY_ADDR_DEF<<1,GW_GRAY_ANALOG_BASE_,Result,len))return 1;
 	else return 0;
 }
+unsigned char IIC_Get_Anolog_DMA(unsigned char * Result,unsigned char len)
+{
+	/* 非阻塞读取，完成后由HAL_I2C_MemRxCpltCallback通知 */
+	return HAL_I2C_Mem_Read_DMA(&hi2c3,GW_GRAY_ADDR_DEF<<1,GW_GRAY_ANALOG_BASE_,I2C_MEMADD_SIZE_8BIT,Result,len)==HAL_OK;
+}
+unsigned char IIC_Get_Digtal_DMA(unsigned char * Result)
+{
+	/* 非阻塞读取1字节数字位图，完成后由HAL_I2C_MemRxCpltCallback通知 */
+	return HAL_I2C_Mem_Read_DMA(&hi2c3,GW_GRAY_ADDR_DEF<<1,GW_GRAY_DIGITAL_MODE,I2C_MEMADD_SIZE_8BIT,Result,1)==HAL_OK;
+}
 unsigned char IIC_Get_Single_Anolog(unsigned char Channel)
 {
 	unsigned char dat;
@@ -4,6 +4,8 @@
 unsigned char Ping(void);
 unsigned char IIC_Get_Digtal(void);
 unsigned char IIC_Get_Anolog(unsigned char * Result,unsigned char len);
+unsigned char IIC_Get_Anolog_DMA(unsigned char * Result,unsigned char len);
+unsigned char IIC_Get_Digtal_DMA(unsigned char * Result);
 unsigned char IIC_Get_Single_Anolog(unsigned char Channel);
 unsigned char IIC_Anolog_Normalize(uint8_t Normalize_channel);
 unsigned short IIC_Get_Offset(void );
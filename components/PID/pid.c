@@ -60,6 +60,37 @@ void pid_set_params(PID_T * _tpPID, float _kp, float _ki, float _kd)
     _tpPID->kd = _kd;
 }
 
+/*******************************************************************************
+ * @brief 无扰切换PID参数(位置式)
+ * @param {PID_T *} _tpPID 指向PID结构体的指针
+ * @param {float} _kp 比例系数
+ * @param {float} _ki 积分系数
+ * @param {float} _kd 微分系数
+ * @return {*}
+ * @note 按新参数反算积分累加值，使切换后输出与上一次输出连续
+ *       out = kp*e + ki*integral + kd*(e - e_prev)
+ *       积分项限制在输出限幅范围内，避免新比例系数过大时反算出的积分造成饱和
+ *       需在pid_set_limit设置新限幅之后调用
+ *******************************************************************************/
+void pid_set_params_bumpless(PID_T * _tpPID, float _kp, float _ki, float _kd)
+{
+    if(_ki != 0.0f)
+    {
+        /* 位置式计算结束时last_error已更新为error，上一次的误差差分由d_out/kd还原 */
+        float delta_error = (_tpPID->kd != 0.0f) ? _tpPID->d_out / _tpPID->kd : 0.0f;
+        float i_out = _tpPID->out - _kp * _tpPID->error - _kd * delta_error;
+
+        i_out = pid_constrain(i_out, -_tpPID->limit, _tpPID->limit);
+        _tpPID->integral = i_out / _ki;
+    }
+    else
+        _tpPID->integral = 0;   // 无积分项时无法保持输出，仅清零
+
+    _tpPID->kp = _kp;
+    _tpPID->ki = _ki;
+    _tpPID->kd = _kd;
+}
+
 /*******************************************************************************
  * @brief 设置PID输出限幅
  * @param {PID_T *} _tpPID 指向PID结构体的指针
@@ -89,6 +120,22 @@ void pid_reset(PID_T * _tpPID)
     _tpPID->d_out = 0;
 }
 
+/*******************************************************************************
+ * @brief 重置PID控制器并以当前误差作为历史误差
+ * @param {PID_T *} _tpPID 指向PID结构体的指针
+ * @param {float} _error 当前误差(target - current)
+ * @return {*}
+ * @note 积分和输出清零，last_error/last2_error取_error，
+ *       下一次计算的微分项只反映之后的误差变化，避免中断后恢复时的微分冲击
+ *******************************************************************************/
+void pid_reset_to(PID_T * _tpPID, float _error)
+{
+    pid_reset(_tpPID);
+    _tpPID->error = _error;
+    _tpPID->last_error = _error;
+    _tpPID->last2_error = _error;
+}
+
 /*******************************************************************************
  * @brief 计算位置式PID
  * @param {PID_T *} _tpPID 指向PID结构体的指针
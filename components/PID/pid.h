@@ -32,12 +32,18 @@ void pid_set_target(PID_T * _tpPID, float _target);
 /* 设置PID参数 */
 void pid_set_params(PID_T * _tpPID, float _kp, float _ki, float _kd);
 
+/* 无扰切换PID参数(位置式) */
+void pid_set_params_bumpless(PID_T * _tpPID, float _kp, float _ki, float _kd);
+
 /* 设置PID输出限幅 */
 void pid_set_limit(PID_T * _tpPID, float _limit);
 
 /* 重置PID控制器 */
 void pid_reset(PID_T * _tpPID);
 
+/* 重置PID控制器并以当前误差作为历史误差(无微分冲击) */
+void pid_reset_to(PID_T * _tpPID, float _error);
+
 /* 计算位置式PID */
 float pid_calculate_positional(PID_T * _tpPID, float _current);
 
@@ -0,0 +1,126 @@
+#include "pid_bank.h"
+#include <math.h>
+
+/*******************************************************************************
+ * @brief 控制器组初始化函数
+ * @param {PID_Bank_T *} _tpBank 指向控制器组的指针
+ * @param {uint8_t} _count 控制器数量，超过PID_BANK_MAX时截断
+ * @return {*}
+ * @note 参数、目标、限幅、状态全部清零，使用前需逐个设置参数和限幅
+ *******************************************************************************/
+void pid_bank_init(PID_Bank_T * _tpBank, uint8_t _count)
+{
+    if(_count > PID_BANK_MAX)
+        _count = PID_BANK_MAX;
+
+    _tpBank->count = _count;
+    for(uint8_t i = 0; i < PID_BANK_MAX; i++)
+    {
+        pid_bank_set_params(_tpBank, i, 0.0f, 0.0f, 0.0f);
+        pid_bank_reset(_tpBank, i);
+        _tpBank->target[i] = 0.0f;
+        _tpBank->out_min[i] = 0.0f;
+        _tpBank->out_max[i] = 0.0f;
+    }
+}
+
+/*******************************************************************************
+ * @brief 设置单个控制器参数
+ * @param {PID_Bank_T *} _tpBank 指向控制器组的指针
+ * @param {uint8_t} _idx 控制器编号
+ * @param {float} _kp 比例系数
+ * @param {float} _ki 积分系数
+ * @param {float} _kd 微分系数
+ * @return {*}
+ * @note 差分方程以上一次输出为起点累加，运行中换参数输出自然连续
+ *******************************************************************************/
+void pid_bank_set_params(PID_Bank_T * _tpBank, uint8_t _idx, float _kp, float _ki, float _kd)
+{
+    if(_idx >= PID_BANK_MAX)
+        return;
+
+    _tpBank->A0[_idx] = _kp + _ki + _kd;
+    _tpBank->A1[_idx] = -_kp - 2.0f * _kd;
+    _tpBank->A2[_idx] = _kd;
+}
+
+/*******************************************************************************
+ * @brief 设置单个控制器输出限幅
+ * @param {PID_Bank_T *} _tpBank 指向控制器组的指针
+ * @param {uint8_t} _idx 控制器编号
+ * @param {float} _min 输出下限
+ * @param {float} _max 输出上限
+ * @return {*}
+ *******************************************************************************/
+void pid_bank_set_limit(PID_Bank_T * _tpBank, uint8_t _idx, float _min, float _max)
+{
+    if(_idx >= PID_BANK_MAX)
+        return;
+
+    _tpBank->out_min[_idx] = _min;
+    _tpBank->out_max[_idx] = _max;
+}
+
+/*******************************************************************************
+ * @brief 设置单个控制器目标值
+ * @param {PID_Bank_T *} _tpBank 指向控制器组的指针
+ * @param {uint8_t} _idx 控制器编号
+ * @param {float} _target 目标值
+ * @return {*}
+ *******************************************************************************/
+void pid_bank_set_target(PID_Bank_T * _tpBank, uint8_t _idx, float _target)
+{
+    if(_idx >= PID_BANK_MAX)
+        return;
+
+    _tpBank->target[_idx] = _target;
+}
+
+/*******************************************************************************
+ * @brief 重置单个控制器状态
+ * @param {PID_Bank_T *} _tpBank 指向控制器组的指针
+ * @param {uint8_t} _idx 控制器编号
+ * @return {*}
+ * @note 清除历史误差和累加输出，参数与目标值保持不变
+ *******************************************************************************/
+void pid_bank_reset(PID_Bank_T * _tpBank, uint8_t _idx)
+{
+    if(_idx >= PID_BANK_MAX)
+        return;
+
+    _tpBank->x1[_idx] = 0.0f;
+    _tpBank->x2[_idx] = 0.0f;
+    _tpBank->y[_idx] = 0.0f;
+    _tpBank->out[_idx] = 0.0f;
+}
+
+/*******************************************************************************
+ * @brief 一次遍历更新全部控制器
+ * @param {PID_Bank_T *} _tpBank 指向控制器组的指针
+ * @param {const float *} _current 各控制器当前值，长度不小于count
+ * @return {*}
+ * @note 无函数调用、无结构体间跳转，每个控制器3次乘加(fmaf映射为VFMA.F32)
+ *       结果写入out[]，与pid_calculate_positional + pid_constrain结果一致
+ *******************************************************************************/
+void pid_bank_update(PID_Bank_T * _tpBank, const float * _current)
+{
+    const uint8_t n = _tpBank->count;
+
+    for(uint8_t i = 0; i < n; i++)
+    {
+        float e = _tpBank->target[i] - _current[i];
+
+        float y = fmaf(_tpBank->A0[i], e, _tpBank->y[i]);
+        y = fmaf(_tpBank->A1[i], _tpBank->x1[i], y);
+        y = fmaf(_tpBank->A2[i], _tpBank->x2[i], y);
+
+        _tpBank->x2[i] = _tpBank->x1[i];
+        _tpBank->x1[i] = e;
+        _tpBank->y[i] = y;
+
+        /* 输出限幅，状态y不限幅以保持与位置式实现一致 */
+        y = (y > _tpBank->out_max[i]) ? _tpBank->out_max[i] : y;
+        y = (y < _tpBank->out_min[i]) ? _tpBank->out_min[i] : y;
+        _tpBank->out[i] = y;
+    }
+}
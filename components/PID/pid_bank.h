@@ -0,0 +1,57 @@
+#ifndef __PID_BANK_H
+#define __PID_BANK_H
+
+#include <stdint.h>
+
+/*
+    PID控制器组：多个位置式PID按数组(SoA)连续存放，一次遍历更新全部控制器
+    采用与CMSIS-DSP arm_pid_f32相同的差分方程形式：
+        y[n] = y[n-1] + A0*e[n] + A1*e[n-1] + A2*e[n-2]
+        A0 = Kp + Ki + Kd, A1 = -Kp - 2*Kd, A2 = Kd
+    与pid_calculate_positional数学等价(状态y不限幅，只对输出限幅)
+    每个控制器3次fmaf，开启-mfpu=fpv4-sp-d16后映射为VFMA.F32，即面向FPU的实现，
+    无需引入CMSIS-DSP
+*/
+
+#define PID_BANK_MAX            4       /* 单个控制器组最大控制器数 */
+
+/* pid控制器组结构体 */
+typedef struct
+{
+    uint8_t count;                      /* 有效控制器数 */
+
+    float A0[PID_BANK_MAX];             /* e[n]系数 */
+    float A1[PID_BANK_MAX];             /* e[n-1]系数 */
+    float A2[PID_BANK_MAX];             /* e[n-2]系数 */
+    float x1[PID_BANK_MAX];             /* 上一次误差 */
+    float x2[PID_BANK_MAX];             /* 上上次误差 */
+    float y[PID_BANK_MAX];              /* 未限幅输出(累加状态) */
+
+    float target[PID_BANK_MAX];         /* 目标值 */
+    float out_min[PID_BANK_MAX];        /* 输出下限 */
+    float out_max[PID_BANK_MAX];        /* 输出上限 */
+    float out[PID_BANK_MAX];            /* 限幅后的执行量 */
+}PID_Bank_T;
+
+/*
+    提供给用户调用的API
+*/
+/* 控制器组初始化 */
+void pid_bank_init(PID_Bank_T * _tpBank, uint8_t _count);
+
+/* 设置单个控制器参数(运行中修改为无扰切换) */
+void pid_bank_set_params(PID_Bank_T * _tpBank, uint8_t _idx, float _kp, float _ki, float _kd);
+
+/* 设置单个控制器输出限幅 */
+void pid_bank_set_limit(PID_Bank_T * _tpBank, uint8_t _idx, float _min, float _max);
+
+/* 设置单个控制器目标值 */
+void pid_bank_set_target(PID_Bank_T * _tpBank, uint8_t _idx, float _target);
+
+/* 重置单个控制器状态 */
+void pid_bank_reset(PID_Bank_T * _tpBank, uint8_t _idx);
+
+/* 一次遍历更新全部控制器，_current按控制器编号排列 */
+void pid_bank_update(PID_Bank_T * _tpBank, const float * _current);
+
+#endif
@@ -196,6 +196,18 @@ void WitSerialDataIn(uint8_t ucData)
     }
     if(s_uiWitDataCnt == WIT_DATA_BUFF_SIZE)s_uiWitDataCnt = 0;
 }
+/* p_ucFrame: one complete 11-byte normal-protocol frame, header and checksum already verified by caller */
+void WitSerialFrameIn(const uint8_t *p_ucFrame)
+{
+    uint16_t usData[4];
+
+    if(p_WitRegUpdateCbFunc == NULL)return ;
+    usData[0] = ((uint16_t)p_ucFrame[3] << 8) | (uint16_t)p_ucFrame[2];
+    usData[1] = ((uint16_t)p_ucFrame[5] << 8) | (uint16_t)p_ucFrame[4];
+    usData[2] = ((uint16_t)p_ucFrame[7] << 8) | (uint16_t)p_ucFrame[6];
+    usData[3] = ((uint16_t)p_ucFrame[9] << 8) | (uint16_t)p_ucFrame[8];
+    CopeWitData(p_ucFrame[1], usData, 4);
+}
 int32_t WitI2cFuncRegister(WitI2cWrite write_func, WitI2cRead read_func)
 {
     if(!write_func)return WIT_HAL_INVAL;
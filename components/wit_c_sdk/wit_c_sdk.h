@@ -31,6 +31,7 @@ extern "C" {
 typedef void (*SerialWrite)(uint8_t *p_ucData, uint32_t uiLen);
 int32_t WitSerialWriteRegister(SerialWrite write_func);
 void WitSerialDataIn(uint8_t ucData);
+void WitSerialFrameIn(const uint8_t *p_ucFrame);
 
 /* iic function */
 
@@ -0,0 +1,29 @@
+/**
+ * @file control_bench_host.c
+ * @brief 闭环基准测试主机端入口 - 以固件默认参数运行bench场景并输出CSV
+ * @note 用法: control_bench [step|ramp|disturb|line]，无参数时运行全部场景
+ *       参数取自pid_core.c中的默认值和mydefine.h中的速度规划限制，
+ *       修改参数后重新编译即可离线对比；cycles列需在目标板上用bench指令获取
+ */
+#include "mydefine.h"
+
+int main(int argc, char **argv) {
+    PID_Params_Init();
+    Profile_Init(&speed_profile, PROFILE_MAX_ACCEL, PROFILE_MAX_JERK);
+    Profile_SetDecel(&speed_profile, PROFILE_MAX_DECEL);
+
+    if (argc < 2) {
+        Bench_Report(-1);
+        return 0;
+    }
+
+    for (int s = 0; s < BENCH_NUM; s++) {
+        if (strcmp(argv[1], Bench_GetName((Bench_Scenario_t)s)) == 0) {
+            Bench_Report(s);
+            return 0;
+        }
+    }
+
+    fprintf(stderr, "无效场景 '%s'，支持的场景: step, ramp, disturb, line\n", argv[1]);
+    return 1;
+}
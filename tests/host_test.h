@@ -0,0 +1,25 @@
+/**
+ * @file host_test.h
+ * @brief 主机端测试公共宏 - 失败时打印位置和说明并计数，main返回失败数
+ */
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+#include <stdio.h>
+
+static int test_failures = 0;
+
+#define TEST_CHECK(cond, ...)                                               \
+    do {                                                                    \
+        if (!(cond)) {                                                      \
+            printf("FAIL %s:%d: ", __FILE__, __LINE__);                     \
+            printf(__VA_ARGS__);                                            \
+            printf("\n");                                                   \
+            test_failures++;                                                \
+        }                                                                   \
+    } while (0)
+
+#define TEST_RESULT()                                                       \
+    (printf("%s\n", test_failures ? "FAILED" : "OK"), test_failures ? 1 : 0)
+
+#endif
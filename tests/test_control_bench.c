@@ -0,0 +1,28 @@
+/**
+ * @file test_control_bench.c
+ * @brief 闭环基准测试时长检查 - 默认参数下阶跃/斜坡/扰动场景须在仿真时长内进入调节带
+ * @note 仿真时长不足时settle_ms恒为-1，基准结果无法比较调参效果
+ */
+#include "mydefine.h"
+#include "host_test.h"
+
+static void check_settles(Bench_Scenario_t scenario) {
+    Bench_Result_t r;
+
+    Bench_Run(scenario, &r);
+    TEST_CHECK(r.settle_ms >= 0.0f, "%s: settle_ms=%.1f, expected a finite settle time",
+               Bench_GetName(scenario), r.settle_ms);
+    TEST_CHECK(isfinite(r.ise), "%s: ise=%f", Bench_GetName(scenario), r.ise);
+}
+
+int main(void) {
+    PID_Params_Init();
+    Profile_Init(&speed_profile, PROFILE_MAX_ACCEL, PROFILE_MAX_JERK);
+    Profile_SetDecel(&speed_profile, PROFILE_MAX_DECEL);
+
+    check_settles(BENCH_STEP);
+    check_settles(BENCH_RAMP);
+    check_settles(BENCH_DISTURB);
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,183 @@
+/**
+ * @file test_line_classifier.c
+ * @brief 循线状态时域分类测试 - 用录制的单帧状态序列检查滞回、最小保持帧数和事件
+ * @note 序列按(单帧状态, 偏差, 帧数)分段描述，1kHz采样下1帧=1ms；
+ *       每帧调用Classifier_TakeEvents，统计各事件被取出的次数
+ */
+#include "mydefine.h"
+#include "host_test.h"
+
+// 录制序列的一段：连续frames帧相同的单帧状态与偏差
+typedef struct {
+    Gary_LineState_t raw;
+    float error;
+    uint16_t frames;
+} Frame_Run_t;
+
+static uint32_t taken[LINE_EVT_NUM];    // 各事件取出次数
+
+/**
+ * @brief 逐帧送入一段序列，每帧取出事件并计数
+ * @retval 最后一帧的稳定状态
+ */
+static uint8_t feed(Line_Classifier_t *cls, const Frame_Run_t *runs, uint8_t n) {
+    uint8_t stable = cls->stable;
+
+    for (uint8_t r = 0; r < n; r++) {
+        for (uint16_t f = 0; f < runs[r].frames; f++) {
+            stable = Classifier_Update(cls, runs[r].raw, runs[r].error);
+            uint8_t evt = Classifier_TakeEvents(cls);
+            for (uint8_t i = 0; i < LINE_EVT_NUM; i++) {
+                if (evt & (1U << i)) taken[i]++;
+            }
+        }
+    }
+    return stable;
+}
+
+static void clear_taken(void) {
+    memset(taken, 0, sizeof(taken));
+}
+
+static uint32_t total_taken(void) {
+    uint32_t sum = 0;
+    for (uint8_t i = 0; i < LINE_EVT_NUM; i++) sum += taken[i];
+    return sum;
+}
+
+/**
+ * @brief 从丢线进入稳定的中央状态 (各测试的公共起点)
+ */
+static void start_on_line(Line_Classifier_t *cls) {
+    static const Frame_Run_t on_line[] = {{LINE_CENTER, 0.0f, 20}};
+
+    Classifier_Init(cls);
+    clear_taken();
+    uint8_t stable = feed(cls, on_line, 1);
+    TEST_CHECK(stable == LINE_CENTER, "on line: stable=%u", stable);
+    TEST_CHECK(taken[5] == 1 && total_taken() == 1, "on line: expected one LINE_FOUND event, got %u total",
+               (unsigned)total_taken());
+    clear_taken();
+}
+
+// 单帧毛刺：中央行驶中夹杂孤立的T/路口/丢线/急剧偏移帧，稳定状态不变且无事件
+static void test_single_frame_glitches(void) {
+    Line_Classifier_t cls;
+    static const Frame_Run_t glitches[] = {
+        {LINE_T_LEFT, -2.5f, 1},       {LINE_CENTER, 0.0f, 6},
+        {LINE_INTERSECTION, 0.0f, 1},  {LINE_CENTER, 0.0f, 3},
+        {LINE_LOST, 0.0f, 1},          {LINE_CENTER, 0.0f, 2},
+        {LINE_T_RIGHT, 2.5f, 1},       {LINE_CENTER, 0.0f, 1},
+        {LINE_SHARP_LEFT, -3.0f, 1},   {LINE_CENTER, 0.0f, 1},
+        {LINE_INTERSECTION, 0.0f, 1},  {LINE_CENTER, 0.0f, 1},
+        {LINE_LOST, 0.0f, 1},          {LINE_CENTER, 0.0f, 1},
+        {LINE_T_LEFT, -2.5f, 1},       {LINE_CENTER, 0.0f, 1},
+        {LINE_T_LEFT, -2.5f, 1},       {LINE_CENTER, 0.0f, 10},
+    };
+
+    start_on_line(&cls);
+    for (uint8_t r = 0; r < sizeof(glitches) / sizeof(glitches[0]); r++) {
+        uint8_t stable = feed(&cls, &glitches[r], 1);
+        TEST_CHECK(stable == LINE_CENTER, "glitch run %u: stable changed to %u", r, stable);
+    }
+    TEST_CHECK(total_taken() == 0, "glitches: %u events emitted", (unsigned)total_taken());
+}
+
+// 确认的左T路口：进入时在T与路口之间闪烁，保持一段时间后回到中央，只产生一次左T事件
+static void test_t_junction_single_event(void) {
+    Line_Classifier_t cls;
+    static const Frame_Run_t crossing[] = {
+        {LINE_T_LEFT, -2.5f, 1}, {LINE_INTERSECTION, 0.0f, 1},
+        {LINE_T_LEFT, -2.5f, 2}, {LINE_INTERSECTION, 0.0f, 1},
+        {LINE_T_LEFT, -2.5f, 40},
+        {LINE_INTERSECTION, 0.0f, 1}, {LINE_T_LEFT, -2.5f, 10},
+        {LINE_CENTER, 0.0f, 30},
+    };
+
+    start_on_line(&cls);
+    uint8_t stable = feed(&cls, crossing, sizeof(crossing) / sizeof(crossing[0]));
+
+    TEST_CHECK(stable == LINE_CENTER, "T junction: final stable=%u", stable);
+    TEST_CHECK(taken[2] == 1, "T junction: T_LEFT taken %u times", (unsigned)taken[2]);
+    TEST_CHECK(total_taken() == 1, "T junction: %u events in total", (unsigned)total_taken());
+    TEST_CHECK(cls.event_count[2] == 1, "T junction: event_count=%u", (unsigned)cls.event_count[2]);
+}
+
+// 偏差滞回：偏差在轻微/中度分界1.5附近抖动不换档，越过分界±GARY_STATE_HYST才换档
+static void test_offset_hysteresis(void) {
+    Line_Classifier_t cls;
+    static const Frame_Run_t slight[] = {{LINE_SLIGHT_RIGHT, 1.0f, 20}};
+    static const Frame_Run_t jitter_up[] = {
+        {LINE_MODERATE_RIGHT, 1.6f, 3}, {LINE_SLIGHT_RIGHT, 1.45f, 1},
+        {LINE_MODERATE_RIGHT, 1.65f, 10},
+    };
+    static const Frame_Run_t cross_up[] = {{LINE_MODERATE_RIGHT, 1.8f, 20}};
+    static const Frame_Run_t jitter_down[] = {{LINE_SLIGHT_RIGHT, 1.4f, 20}};
+    static const Frame_Run_t cross_down[] = {{LINE_SLIGHT_RIGHT, 1.2f, 20}};
+
+    start_on_line(&cls);
+    TEST_CHECK(feed(&cls, slight, 1) == LINE_SLIGHT_RIGHT, "hysteresis: not settled on slight right");
+
+    TEST_CHECK(feed(&cls, jitter_up, 3) == LINE_SLIGHT_RIGHT, "hysteresis: switched inside band going up");
+    TEST_CHECK(cls.frame == LINE_SLIGHT_RIGHT, "hysteresis: frame=%u inside band", cls.frame);
+
+    TEST_CHECK(feed(&cls, cross_up, 1) == LINE_MODERATE_RIGHT, "hysteresis: no switch above band");
+
+    TEST_CHECK(feed(&cls, jitter_down, 1) == LINE_MODERATE_RIGHT, "hysteresis: switched inside band going down");
+    TEST_CHECK(cls.frame == LINE_MODERATE_RIGHT, "hysteresis: frame=%u inside band", cls.frame);
+
+    TEST_CHECK(feed(&cls, cross_down, 1) == LINE_SLIGHT_RIGHT, "hysteresis: no switch below band");
+    TEST_CHECK(total_taken() == 0, "hysteresis: offset changes emitted %u events", (unsigned)total_taken());
+}
+
+// 最小保持帧数：刚确认的状态即使旧状态证据已足够，也要保持LINE_CLASS_MIN_DWELL帧
+static void test_min_dwell(void) {
+    Line_Classifier_t cls;
+    static const Frame_Run_t to_t[] = {{LINE_T_RIGHT, 2.5f, 1}};
+    static const Frame_Run_t back[] = {{LINE_CENTER, 0.0f, 1}};
+    uint16_t frames = 0;
+
+    start_on_line(&cls);
+    while (cls.stable != LINE_T_RIGHT && frames < 100) {
+        feed(&cls, to_t, 1);
+        frames++;
+    }
+    TEST_CHECK(frames == LINE_CLASS_ENTER, "dwell: T_RIGHT confirmed after %u frames", frames);
+
+    for (uint16_t k = 1; k <= LINE_CLASS_MIN_DWELL; k++) {
+        uint8_t stable = feed(&cls, back, 1);
+        if (k < LINE_CLASS_MIN_DWELL) {
+            TEST_CHECK(stable == LINE_T_RIGHT, "dwell: left T_RIGHT after %u frames", k);
+        } else {
+            TEST_CHECK(stable == LINE_CENTER, "dwell: still %u after %u frames", stable, k);
+        }
+    }
+    TEST_CHECK(taken[3] == 1 && total_taken() == 1, "dwell: expected one T_RIGHT event, got %u total",
+               (unsigned)total_taken());
+}
+
+// 丢线：短暂全白不报丢线，持续全白只报一次，找回线也只报一次
+static void test_line_lost_found(void) {
+    Line_Classifier_t cls;
+    static const Frame_Run_t gap[] = {{LINE_LOST, 0.0f, 3}, {LINE_CENTER, 0.0f, 20}};
+    static const Frame_Run_t lost[] = {{LINE_LOST, 0.0f, 50}, {LINE_SEARCHING, 0.0f, 50}, {LINE_CENTER, 0.0f, 20}};
+
+    start_on_line(&cls);
+    TEST_CHECK(feed(&cls, gap, 2) == LINE_CENTER, "lost: short gap changed stable state");
+    TEST_CHECK(total_taken() == 0, "lost: short gap emitted %u events", (unsigned)total_taken());
+
+    TEST_CHECK(feed(&cls, lost, 3) == LINE_CENTER, "lost: not back on line");
+    TEST_CHECK(taken[4] == 1 && taken[5] == 1 && total_taken() == 2,
+               "lost: LINE_LOST=%u LINE_FOUND=%u total=%u",
+               (unsigned)taken[4], (unsigned)taken[5], (unsigned)total_taken());
+}
+
+int main(void) {
+    test_single_frame_glitches();
+    test_t_junction_single_event();
+    test_offset_hysteresis();
+    test_min_dwell();
+    test_line_lost_found();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,103 @@
+/**
+ * @file test_motion_profile.c
+ * @brief 速度规划连续性测试 - 阶跃与中途改目标序列下逐周期检查速度/加速度变化率
+ * @note 每周期要求 Δv ∈ [-D·dt, A·dt]、|Δa| ≤ J·dt、a ∈ [-D, A]，
+ *       并在限定时间内结束过渡(v等于目标，a=0)；从静止出发的单次阶跃不允许超调
+ */
+#include "mydefine.h"
+#include "host_test.h"
+
+#define TEST_DT         PID_CONTROL_PERIOD_S
+#define TEST_EPS        1e-5f
+#define TEST_MAX_TICKS  2000           // 20s内必须结束过渡
+
+// 目标变更：第tick个周期开始前设置新目标
+typedef struct {
+    uint32_t tick;
+    float target;
+} Retarget_t;
+
+/**
+ * @brief 运行一个目标序列并逐周期检查限制
+ * @param name 场景名称
+ * @param v0 初始速度(m/s)
+ * @param seq 目标变更序列 (按tick升序)
+ * @param n 序列长度
+ * @param no_overshoot 1-检查最后一段过渡不越过目标
+ */
+static void run_sequence(const char *name, float v0, const Retarget_t *seq, uint8_t n, uint8_t no_overshoot) {
+    Motion_Profile_t p;
+    uint8_t next = 0;
+    uint32_t tick;
+    float start = v0;
+
+    Profile_Init(&p, PROFILE_MAX_ACCEL, PROFILE_MAX_JERK);
+    Profile_SetDecel(&p, PROFILE_MAX_DECEL);
+    p.target = v0;
+    Profile_Reset(&p, v0);
+
+    for (tick = 0; tick < TEST_MAX_TICKS; tick++) {
+        while (next < n && seq[next].tick == tick) {
+            start = p.v;
+            Profile_SetTarget(&p, seq[next].target);
+            next++;
+        }
+        if (next == n && !p.active) break;
+
+        float v_prev = p.v;
+        float a_prev = p.a;
+        Profile_Update(&p, TEST_DT);
+        float dv = p.v - v_prev;
+        float da = p.a - a_prev;
+
+        TEST_CHECK(dv <= p.max_accel * TEST_DT + TEST_EPS && dv >= -p.max_decel * TEST_DT - TEST_EPS,
+                   "%s tick %u: dv=%.6f exceeds accel/decel limit", name, (unsigned)tick, dv);
+        TEST_CHECK(fabsf(da) <= p.max_jerk * TEST_DT + TEST_EPS,
+                   "%s tick %u: da=%.6f exceeds jerk limit (a %.4f -> %.4f)", name, (unsigned)tick, da, a_prev, p.a);
+        TEST_CHECK(p.a <= p.max_accel + TEST_EPS && p.a >= -p.max_decel - TEST_EPS,
+                   "%s tick %u: a=%.4f out of range", name, (unsigned)tick, p.a);
+        if (no_overshoot && next == n) {
+            float over = (p.target > start) ? p.v - p.target : p.target - p.v;
+            TEST_CHECK(over <= TEST_EPS, "%s tick %u: overshoot %.6f", name, (unsigned)tick, over);
+        }
+    }
+
+    TEST_CHECK(!p.active, "%s: transition not finished after %u ticks (v=%.5f a=%.4f)",
+               name, (unsigned)tick, p.v, p.a);
+    TEST_CHECK(p.v == p.target && p.a == 0.0f, "%s: final v=%.6f a=%.6f target=%.3f",
+               name, p.v, p.a, p.target);
+}
+
+int main(void) {
+    // 单次阶跃：大阶跃为梯形，小阶跃为三角形(达不到最大加速度)
+    static const Retarget_t step_up[]    = {{0, 1.0f}};
+    static const Retarget_t step_down[]  = {{0, 0.0f}};
+    static const Retarget_t step_small[] = {{0, 0.05f}};
+    static const Retarget_t step_tiny[]  = {{0, 0.001f}};
+    run_sequence("step 0->1.0", 0.0f, step_up, 1, 1);
+    run_sequence("step 1.0->0", 1.0f, step_down, 1, 1);
+    run_sequence("step 0->0.05", 0.0f, step_small, 1, 1);
+    run_sequence("step 0->0.001", 0.0f, step_tiny, 1, 1);
+
+    // 中途改目标：加速中降低目标、加速中反向、改为当前速度、减速中再提速
+    static const Retarget_t lower[]    = {{0, 1.0f}, {10, 0.3f}};
+    static const Retarget_t reverse[]  = {{0, 1.0f}, {20, 0.0f}};
+    static const Retarget_t hold[]     = {{0, 1.0f}, {8, 0.1f}};
+    static const Retarget_t reaccel[]  = {{0, 0.2f}, {15, 1.5f}, {40, 0.5f}, {45, 0.8f}};
+    static const Retarget_t chatter[]  = {{0, 0.5f}, {3, 0.51f}, {6, 0.49f}, {9, 0.5f}, {12, 0.0f}};
+    run_sequence("retarget lower", 0.0f, lower, 2, 0);
+    run_sequence("retarget reverse", 0.0f, reverse, 2, 0);
+    run_sequence("retarget hold", 0.0f, hold, 2, 0);
+    run_sequence("retarget reaccel", 0.0f, reaccel, 4, 0);
+    run_sequence("retarget chatter", 0.0f, chatter, 5, 0);
+
+    // 加速过程中不同时刻降低目标
+    for (uint32_t t = 1; t < 60; t += 3) {
+        Retarget_t seq[2] = {{0, 1.0f}, {t, 0.4f}};
+        char name[32];
+        snprintf(name, sizeof(name), "retarget @%u", (unsigned)t);
+        run_sequence(name, 0.0f, seq, 2, 0);
+    }
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,35 @@
+/**
+ * @file test_pid.c
+ * @brief PID基础函数测试 - 以当前误差重置后的首拍无微分冲击
+ */
+#include "mydefine.h"
+#include "host_test.h"
+
+// 循线环重新找到线：按丢线前状态计算会产生Kd·e的冲击，pid_reset_to后首拍只有比例项
+static void test_reset_to_no_derivative_kick(void) {
+    PID_T pid;
+    const float e = 0.3f;                    // 归一化偏差 (灰度偏差1.2/4)
+
+    pid_init(&pid, line.Kp, line.Ki, line.Kd, 0.0f, line.out_max);
+    pid_calculate_positional(&pid, -0.5f);   // 丢线前的偏差
+    pid_reset(&pid);
+    pid_calculate_positional(&pid, e);
+    TEST_CHECK(pid.d_out != 0.0f, "pid_reset: expected a derivative kick, d_out=%.4f", pid.d_out);
+
+    pid_init(&pid, line.Kp, line.Ki, line.Kd, 0.0f, line.out_max);
+    pid_calculate_positional(&pid, -0.5f);
+    pid_reset_to(&pid, pid.target - e);
+    float out = pid_calculate_positional(&pid, e);
+    TEST_CHECK(pid.d_out == 0.0f, "pid_reset_to: d_out=%.4f", pid.d_out);
+    TEST_CHECK(fabsf(out - line.Kp * -e) < 1e-5f, "pid_reset_to: out=%.4f, expected %.4f", out, line.Kp * -e);
+
+    // 之后的微分项只反映重置后的误差变化
+    pid_calculate_positional(&pid, e + 0.01f);
+    TEST_CHECK(fabsf(pid.d_out - line.Kd * -0.01f) < 1e-3f, "pid_reset_to: next d_out=%.4f", pid.d_out);
+}
+
+int main(void) {
+    test_reset_to_no_derivative_kick();
+
+    return TEST_RESULT();
+}